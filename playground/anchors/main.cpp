@@ -3,10 +3,9 @@
  *           SPDX-License-Identifier: BSD-3-Clause
  *****************************************************************************/
 
-#include "AnchorBox.h"
-
 #include <SkinnyShortcut.h>
 
+#include <QskAnchorBox.h>
 #include <QskControl.h>
 #include <QskObjectCounter.h>
 #include <QskWindow.h>
@@ -46,11 +45,11 @@ class TestRectangle : public QskControl
 };
 
 
-class MyBox : public AnchorBox
+class MyBox : public QskAnchorBox
 {
   public:
     MyBox( QQuickItem* parent = nullptr )
-        : AnchorBox( parent )
+        : QskAnchorBox( parent )
     {
         setObjectName( "Box" );
         setup1();
@@ -63,7 +62,7 @@ class MyBox : public AnchorBox
   protected:
     virtual void geometryChangeEvent( QskGeometryChangeEvent* event ) override
     {
-        AnchorBox::geometryChangeEvent( event );
+        QskAnchorBox::geometryChangeEvent( event );
     }
 };
 
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "Benchmark.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QDateTime>
+
+#include <atomic>
+#include <cstdlib>
+
+static std::atomic< qint64 > qskAllocations { 0 };
+
+#if defined( __GLIBC__ )
+
+/*
+    Counting the allocations by interposing the allocation functions
+    of the C library, what also covers the libraries of Qt and QSkinny.
+ */
+
+extern "C"
+{
+    void* __libc_malloc( size_t );
+    void* __libc_calloc( size_t, size_t );
+    void* __libc_realloc( void*, size_t );
+
+    void* malloc( size_t size )
+    {
+        qskAllocations.fetch_add( 1, std::memory_order_relaxed );
+        return __libc_malloc( size );
+    }
+
+    void* calloc( size_t count, size_t size )
+    {
+        qskAllocations.fetch_add( 1, std::memory_order_relaxed );
+        return __libc_calloc( count, size );
+    }
+
+    void* realloc( void* ptr, size_t size )
+    {
+        qskAllocations.fetch_add( 1, std::memory_order_relaxed );
+        return __libc_realloc( ptr, size );
+    }
+}
+
+#endif
+
+using namespace Benchmark;
+
+qint64 Benchmark::allocationCount()
+{
+#if defined( __GLIBC__ )
+    return qskAllocations.load( std::memory_order_relaxed );
+#else
+    return -1;
+#endif
+}
+
+void Report::add( const QString& scenario, int itemCount,
+    const char* operation, int iterations, qreal usecs, qreal allocations )
+{
+    Entry entry;
+    entry.scenario = scenario;
+    entry.operation = QString::fromLatin1( operation );
+    entry.itemCount = itemCount;
+    entry.iterations = iterations;
+    entry.usecs = usecs;
+    entry.allocations = allocations;
+
+    m_entries += entry;
+
+    // some progress for the impatient
+    QTextStream( stderr ) << scenario << ": " << operation << '\n';
+}
+
+QByteArray Report::toText() const
+{
+    QByteArray text;
+
+    QTextStream out( &text );
+
+    for ( const auto& entry : m_entries )
+    {
+        out << entry.scenario.leftJustified( 30 )
+            << entry.operation.leftJustified( 16 )
+            << QString::number( entry.usecs, 'f', 1 ).rightJustified( 14 )
+            << " us";
+
+        if ( entry.allocations >= 0.0 )
+        {
+            out << QString::number( entry.allocations, 'f', 1 ).rightJustified( 12 )
+                << " allocs";
+        }
+
+        out << '\n';
+    }
+
+    out.flush();
+    return text;
+}
+
+QByteArray Report::toJson() const
+{
+    QJsonArray results;
+
+    for ( const auto& entry : m_entries )
+    {
+        QJsonObject result;
+        result[ QStringLiteral( "scenario" ) ] = entry.scenario;
+        result[ QStringLiteral( "operation" ) ] = entry.operation;
+        result[ QStringLiteral( "items" ) ] = entry.itemCount;
+        result[ QStringLiteral( "iterations" ) ] = entry.iterations;
+        result[ QStringLiteral( "usecs" ) ] = entry.usecs;
+
+        if ( entry.allocations >= 0.0 )
+            result[ QStringLiteral( "allocations" ) ] = entry.allocations;
+
+        results += result;
+    }
+
+    QJsonObject object;
+    object[ QStringLiteral( "qt" ) ] = QString::fromLatin1( qVersion() );
+    object[ QStringLiteral( "timestamp" ) ] =
+        QDateTime::currentDateTimeUtc().toString( Qt::ISODate );
+    object[ QStringLiteral( "results" ) ] = results;
+
+    return QJsonDocument( object ).toJson();
+}
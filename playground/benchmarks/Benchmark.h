@@ -0,0 +1,60 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+
+namespace Benchmark
+{
+    // average time of an operation in microseconds
+    template< typename T >
+    qreal measure( int iterations, T operation )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int i = 0; i < iterations; i++ )
+            operation( i );
+
+        return timer.nsecsElapsed() / ( 1000.0 * qMax( iterations, 1 ) );
+    }
+
+    /*
+        Number of heap allocations - malloc/calloc/realloc, what includes
+        operator new and the Qt containers - since the start of the process.
+        -1, when counting is not supported for the platform.
+     */
+    qint64 allocationCount();
+
+    class Report
+    {
+      public:
+        // allocations: average number for an operation, -1 for not counted
+        void add( const QString& scenario, int itemCount,
+            const char* operation, int iterations, qreal usecs,
+            qreal allocations = -1.0 );
+
+        QByteArray toText() const;
+        QByteArray toJson() const;
+
+      private:
+        class Entry
+        {
+          public:
+            QString scenario;
+            QString operation;
+
+            int itemCount;
+            int iterations;
+            qreal usecs;
+            qreal allocations;
+        };
+
+        QVector< Entry > m_entries;
+    };
+}
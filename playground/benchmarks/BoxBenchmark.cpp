@@ -0,0 +1,201 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "BoxBenchmark.h"
+#include "Benchmark.h"
+
+#include <QskBoxBorderColors.h>
+#include <QskBoxBorderMetrics.h>
+#include <QskBoxHints.h>
+#include <QskBoxRectangleNode.h>
+#include <QskBoxRenderer.h>
+#include <QskBoxShapeMetrics.h>
+#include <QskGradient.h>
+#include <QskVertex.h>
+
+#include <QDebug>
+#include <QSGGeometry>
+
+BoxBenchmark::BoxBenchmark( int count )
+    : m_count( count )
+{
+    m_name = QStringLiteral( "Box %1" ).arg( count );
+
+    m_rects.reserve( count );
+    m_radii.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        // deterministic, so that the results can be compared between commits
+        const qreal w = 40 + ( i * 7 ) % 200;
+        const qreal h = 20 + ( i * 13 ) % 100;
+
+        m_rects += QRectF( i % 100, i % 50, w, h );
+        m_radii += 2 + ( i * 3 ) % 30;
+    }
+}
+
+bool BoxBenchmark::verifyArcTables() const
+{
+    using QskVertex::ArcIterator;
+
+    for ( int stepCount = 1; stepCount <= ArcIterator::MaxTableStepCount; stepCount++ )
+    {
+        for ( const bool inverted : { false, true } )
+        {
+            ArcIterator it1( stepCount, inverted );
+
+            ArcIterator it2;
+            it2.resetIncremental( stepCount, inverted );
+
+            for ( ; !it1.isDone(); ++it1, ++it2 )
+            {
+                if ( it2.isDone() || it1.cos() != it2.cos() || it1.sin() != it2.sin() )
+                {
+                    qWarning() << "ArcIterator: table differs for" << stepCount << inverted;
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void BoxBenchmark::run( Benchmark::Report& report, int iterations )
+{
+    using namespace Benchmark;
+    using QskVertex::ArcIterator;
+
+    if ( !verifyArcTables() )
+        return;
+
+    double sum = 0.0; // avoiding, that the loops are optimized away
+
+    // iterating over all corners: from the tables and incremental
+
+    auto usecs = measure( iterations,
+        [this, &sum]( int )
+        {
+            for ( const auto radius : qAsConst( m_radii ) )
+            {
+                for ( int i = 0; i < 4; i++ )
+                {
+                    ArcIterator it( ArcIterator::segmentHint( radius ) );
+                    for ( ; !it.isDone(); ++it )
+                        sum += it.cos() * radius + it.sin() * radius;
+                }
+            }
+        }
+    );
+    report.add( m_name, m_count, "arcTable", iterations, usecs );
+
+    usecs = measure( iterations,
+        [this, &sum]( int )
+        {
+            for ( const auto radius : qAsConst( m_radii ) )
+            {
+                for ( int i = 0; i < 4; i++ )
+                {
+                    ArcIterator it;
+                    it.resetIncremental( ArcIterator::segmentHint( radius ) );
+
+                    for ( ; !it.isDone(); ++it )
+                        sum += it.cos() * radius + it.sin() * radius;
+                }
+            }
+        }
+    );
+    report.add( m_name, m_count, "arcIncremental", iterations, usecs );
+
+    // the complete geometry of a box with border and fill
+
+    QSGGeometry geometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 );
+
+    const QskBoxBorderMetrics borderMetrics( 2 );
+    const QskBoxBorderColors borderColors( Qt::darkBlue );
+    const QskGradient gradient( Qt::lightGray );
+
+    usecs = measure( iterations,
+        [&]( int )
+        {
+            for ( int i = 0; i < m_count; i++ )
+            {
+                QskBox::renderBox( m_rects[i], QskBoxShapeMetrics( m_radii[i] ),
+                    borderMetrics, borderColors, gradient, geometry );
+            }
+        }
+    );
+    report.add( m_name, m_count, "renderBox", iterations, usecs );
+
+    // the interpolated hints of a hover animation with monochrome colors
+
+    const QskBoxHints hints1( QskBoxShapeMetrics( 4 ), borderMetrics,
+        borderColors, gradient, QskShadowMetrics(), QColor() );
+
+    const QskBoxHints hints2( QskBoxShapeMetrics( 4 ), borderMetrics,
+        QskBoxBorderColors( Qt::blue ), QskGradient( Qt::white ),
+        QskShadowMetrics(), QColor() );
+
+    const auto allocations = allocationCount();
+
+    usecs = measure( iterations,
+        [&]( int )
+        {
+            for ( int i = 0; i < m_count; i++ )
+            {
+                const auto hints = hints1.interpolated( hints2, qreal( i ) / m_count );
+                sum += qRed( hints.gradient.rgbStart() );
+            }
+        }
+    );
+
+    report.add( m_name, m_count, "interpolateHints", iterations, usecs,
+        ( allocations < 0 ) ? -1.0
+            : qreal( allocationCount() - allocations ) / qMax( iterations, 1 ) );
+
+    // color transitions of plain boxes, where the geometry does not change
+
+    for ( const auto policy : { QskBoxRectangleNode::VertexColors,
+        QskBoxRectangleNode::FlatColors } )
+    {
+        QVector< QskBoxRectangleNode* > nodes;
+        nodes.reserve( m_count );
+
+        for ( int i = 0; i < m_count; i++ )
+        {
+            auto node = new QskBoxRectangleNode();
+            node->setColorPolicy( policy );
+            node->updateNode( m_rects[i], QskBoxShapeMetrics( m_radii[i] ),
+                QskBoxBorderMetrics(), QskBoxBorderColors(), gradient );
+
+            nodes += node;
+        }
+
+        usecs = measure( iterations,
+            [&]( int iteration )
+            {
+                const QskGradient fillGradient(
+                    ( iteration % 2 ) ? Qt::white : Qt::lightGray );
+
+                for ( int i = 0; i < m_count; i++ )
+                {
+                    nodes[i]->updateNode( m_rects[i], QskBoxShapeMetrics( m_radii[i] ),
+                        QskBoxBorderMetrics(), QskBoxBorderColors(), fillGradient );
+                }
+            }
+        );
+
+        report.add( m_name, m_count,
+            ( policy == QskBoxRectangleNode::FlatColors )
+                ? "colorUpdateFlat" : "colorUpdateVertex",
+            iterations, usecs );
+
+        qDeleteAll( nodes );
+    }
+
+    if ( sum == 0.0 )
+        qDebug() << sum;
+}
@@ -0,0 +1,36 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#pragma once
+
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+namespace Benchmark
+{
+    class Report;
+}
+
+class BoxBenchmark
+{
+  public:
+    /*
+        Creating the vertices for count rounded boxes of different
+        sizes and radii, like it happens when resizing a screen.
+     */
+    BoxBenchmark( int count );
+
+    void run( Benchmark::Report&, int iterations );
+
+  private:
+    bool verifyArcTables() const;
+
+    QString m_name;
+    int m_count;
+
+    QVector< QRectF > m_rects;
+    QVector< qreal > m_radii;
+};
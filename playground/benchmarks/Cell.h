@@ -0,0 +1,23 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#pragma once
+
+#include <QskControl.h>
+
+// a control without any visual representation, that only has size hints
+
+class Cell : public QskControl
+{
+  public:
+    Cell( QQuickItem* parent = nullptr )
+        : QskControl( parent )
+    {
+        initSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Preferred );
+
+        setMinimumSize( 10, 10 );
+        setPreferredSize( 50, 20 );
+    }
+};
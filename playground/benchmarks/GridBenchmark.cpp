@@ -0,0 +1,82 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "GridBenchmark.h"
+#include "Benchmark.h"
+#include "Cell.h"
+
+#include <QQuickItem>
+
+GridBenchmark::GridBenchmark( int rows, int columns, int spanFrequency )
+    : m_root( new QQuickItem() )
+    , m_rows( rows )
+    , m_columns( columns )
+    , m_spanFrequency( spanFrequency )
+{
+    m_name = QStringLiteral( "Grid %1x%2" ).arg( rows ).arg( columns );
+}
+
+GridBenchmark::~GridBenchmark()
+{
+    m_engine.clear();
+    delete m_root;
+}
+
+void GridBenchmark::run( Benchmark::Report& report, int iterations )
+{
+    using namespace Benchmark;
+
+    auto usecs = measure( 1,
+        [this]( int )
+        {
+            for ( int row = 0; row < m_rows; row++ )
+            {
+                for ( int col = 0; col < m_columns; col++ )
+                {
+                    m_engine.insertItem( new Cell( m_root ), QRect( col, row, 1, 1 ) );
+
+                    if ( ( row * m_columns + col ) % m_spanFrequency == 0 )
+                    {
+                        const QRect grid( col, row, 3, 2 );
+                        m_engine.insertItem( new Cell( m_root ), grid );
+                    }
+                }
+            }
+        }
+    );
+
+    const int count = m_engine.count();
+    report.add( m_name, count, "insert", 1, usecs );
+
+    const auto hint = m_engine.sizeHint( Qt::PreferredSize, QSizeF() );
+
+    usecs = measure( iterations,
+        [this]( int )
+        {
+            m_engine.invalidate();
+            m_engine.sizeHint( Qt::PreferredSize, QSizeF() );
+        }
+    );
+    report.add( m_name, count, "sizeHint", iterations, usecs );
+
+    usecs = measure( iterations,
+        [this, hint]( int i )
+        {
+            m_engine.invalidate();
+            m_engine.setGeometries( QRectF( QPointF(), hint * ( 1.0 + 0.01 * i ) ) );
+        }
+    );
+    report.add( m_name, count, "setGeometries", iterations, usecs );
+
+    // chains are up to date, only the segments have to be recalculated
+
+    usecs = measure( iterations,
+        [this, hint]( int i )
+        {
+            m_engine.setGeometries( QRectF( QPointF(), hint * ( 1.0 + 0.01 * i ) ) );
+        }
+    );
+    report.add( m_name, count, "resize", iterations, usecs );
+}
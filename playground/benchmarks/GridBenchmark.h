@@ -0,0 +1,39 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#pragma once
+
+#include <QskGridLayoutEngine.h>
+#include <QString>
+
+class QQuickItem;
+
+namespace Benchmark
+{
+    class Report;
+}
+
+class GridBenchmark
+{
+  public:
+    /*
+        A grid of rows x columns controls, where every spanFrequency-th
+        cell is additionally covered by a control spanning 2 rows and 3 columns.
+     */
+    GridBenchmark( int rows, int columns, int spanFrequency = 7 );
+    ~GridBenchmark();
+
+    void run( Benchmark::Report&, int iterations );
+
+  private:
+    QString m_name;
+
+    QskGridLayoutEngine m_engine;
+    QQuickItem* m_root;
+
+    int m_rows;
+    int m_columns;
+    int m_spanFrequency;
+};
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "LinearBenchmark.h"
+#include "Benchmark.h"
+#include "Cell.h"
+
+#include <QQuickItem>
+
+LinearBenchmark::LinearBenchmark(
+        Qt::Orientation orientation, int count, uint dimension )
+    : m_engine( orientation, dimension )
+    , m_root( new QQuickItem() )
+    , m_count( count )
+{
+    m_name = QStringLiteral( "Linear %1 %2/%3" )
+        .arg( orientation == Qt::Horizontal ? "H" : "V" )
+        .arg( count ).arg( dimension );
+}
+
+LinearBenchmark::~LinearBenchmark()
+{
+    m_engine.clear();
+    delete m_root;
+}
+
+void LinearBenchmark::run( Benchmark::Report& report, int iterations )
+{
+    using namespace Benchmark;
+
+    auto usecs = measure( 1,
+        [this]( int )
+        {
+            for ( int i = 0; i < m_count; i++ )
+                m_engine.addItem( new Cell( m_root ) );
+        }
+    );
+    report.add( m_name, m_count, "insert", 1, usecs );
+
+    const auto hint = m_engine.sizeHint( Qt::PreferredSize, QSizeF() );
+
+    usecs = measure( iterations,
+        [this]( int )
+        {
+            m_engine.invalidate();
+            m_engine.sizeHint( Qt::PreferredSize, QSizeF() );
+        }
+    );
+    report.add( m_name, m_count, "sizeHint", iterations, usecs );
+
+    usecs = measure( iterations,
+        [this, hint]( int i )
+        {
+            m_engine.invalidate();
+            m_engine.setGeometries( QRectF( QPointF(), hint * ( 1.0 + 0.01 * i ) ) );
+        }
+    );
+    report.add( m_name, m_count, "setGeometries", iterations, usecs );
+
+    usecs = measure( iterations,
+        [this, hint]( int i )
+        {
+            m_engine.setGeometries( QRectF( QPointF(), hint * ( 1.0 + 0.01 * i ) ) );
+        }
+    );
+    report.add( m_name, m_count, "resize", iterations, usecs );
+}
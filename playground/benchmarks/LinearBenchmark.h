@@ -0,0 +1,37 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#pragma once
+
+#include <QskLinearLayoutEngine.h>
+#include <QString>
+
+class QQuickItem;
+
+namespace Benchmark
+{
+    class Report;
+}
+
+class LinearBenchmark
+{
+  public:
+    /*
+        count controls, that are wrapped into rows/columns
+        of dimension elements
+     */
+    LinearBenchmark( Qt::Orientation, int count, uint dimension = 1 );
+    ~LinearBenchmark();
+
+    void run( Benchmark::Report&, int iterations );
+
+  private:
+    QString m_name;
+
+    QskLinearLayoutEngine m_engine;
+    QQuickItem* m_root;
+
+    int m_count;
+};
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "PolishBenchmark.h"
+#include "Benchmark.h"
+#include "Cell.h"
+
+#include <QskGridBox.h>
+#include <QskLinearBox.h>
+
+#include <cmath>
+
+PolishBenchmark::PolishBenchmark( Type type, int count, int depth )
+    : m_type( type )
+    , m_count( count )
+    , m_depth( qMax( depth, 1 ) )
+{
+    m_name = QStringLiteral( "Polish %1 %2/%3" )
+        .arg( type == Linear ? "Linear" : "Grid" )
+        .arg( count ).arg( m_depth );
+}
+
+PolishBenchmark::~PolishBenchmark()
+{
+    delete m_root;
+}
+
+QskControl* PolishBenchmark::createBox( QQuickItem* parent, int level ) const
+{
+    const int count = m_count / m_depth;
+
+    if ( m_type == Linear )
+    {
+        const auto orientation = ( level % 2 ) ? Qt::Horizontal : Qt::Vertical;
+
+        auto box = new QskLinearBox( orientation, parent );
+        for ( int i = 0; i < count; i++ )
+            box->addItem( new Cell() );
+
+        if ( level < m_depth - 1 )
+            box->addItem( createBox( nullptr, level + 1 ) );
+
+        m_linearBoxes += box;
+        return box;
+    }
+    else
+    {
+        const int columns = qMax( 1, qRound( std::sqrt( count ) ) );
+
+        auto box = new QskGridBox( parent );
+        for ( int i = 0; i < count; i++ )
+            box->addItem( new Cell(), i / columns, i % columns );
+
+        if ( level < m_depth - 1 )
+        {
+            const int row = box->rowCount();
+            box->addItem( createBox( nullptr, level + 1 ), row, 0, 1, columns );
+        }
+
+        m_gridBoxes += box;
+        return box;
+    }
+}
+
+void PolishBenchmark::invalidate()
+{
+    for ( auto box : qAsConst( m_linearBoxes ) )
+        box->invalidate();
+
+    for ( auto box : qAsConst( m_gridBoxes ) )
+        box->invalidate();
+}
+
+void PolishBenchmark::run( Benchmark::Report& report, int iterations )
+{
+    using namespace Benchmark;
+
+    auto usecs = measure( 1,
+        [this]( int )
+        {
+            m_root = createBox( nullptr, 0 );
+            m_window.addItem( m_root );
+        }
+    );
+    report.add( m_name, m_count, "insert", 1, usecs );
+
+    const auto hint = m_root->effectiveSizeHint( Qt::PreferredSize );
+
+    m_root->setSize( hint );
+    m_window.polishItems();
+
+    usecs = measure( iterations,
+        [this]( int )
+        {
+            invalidate();
+            m_root->effectiveSizeHint( Qt::PreferredSize );
+        }
+    );
+    report.add( m_name, m_count, "sizeHint", iterations, usecs );
+
+    m_window.polishItems();
+
+    // resizing the root item, all nested boxes have to be laid out again
+
+    usecs = measure( iterations,
+        [this, hint]( int i )
+        {
+            m_root->setSize( hint * ( 1.0 + 0.01 * ( i + 1 ) ) );
+            m_window.polishItems();
+        }
+    );
+    report.add( m_name, m_count, "polish", iterations, usecs );
+}
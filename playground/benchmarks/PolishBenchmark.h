@@ -0,0 +1,54 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#pragma once
+
+#include <QskWindow.h>
+#include <QString>
+#include <QVector>
+
+class QskControl;
+class QskLinearBox;
+class QskGridBox;
+
+namespace Benchmark
+{
+    class Report;
+}
+
+class PolishBenchmark
+{
+  public:
+    enum Type
+    {
+        Linear,
+        Grid
+    };
+
+    /*
+        A hierarchy of nested boxes of the given depth, where each box
+        contains count / depth controls and the box of the next level.
+     */
+    PolishBenchmark( Type, int count, int depth );
+    ~PolishBenchmark();
+
+    void run( Benchmark::Report&, int iterations );
+
+  private:
+    QskControl* createBox( QQuickItem* parent, int level ) const;
+    void invalidate();
+
+    QString m_name;
+
+    Type m_type;
+    int m_count;
+    int m_depth;
+
+    QskWindow m_window;
+    QskControl* m_root = nullptr;
+
+    mutable QVector< QskLinearBox* > m_linearBoxes;
+    mutable QVector< QskGridBox* > m_gridBoxes;
+};
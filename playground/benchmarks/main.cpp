@@ -0,0 +1,136 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "Benchmark.h"
+#include "BoxBenchmark.h"
+#include "GridBenchmark.h"
+#include "LinearBenchmark.h"
+#include "PolishBenchmark.h"
+
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QQuickWindow>
+#include <QFile>
+#include <QDebug>
+
+/*
+    Headless benchmarks for the layout code in src/layouts. The scenarios
+    are similar to the test cases of playground/grids, but scaled up
+    to 10000 items and nested boxes of a depth up to 10.
+
+    BoxBenchmark measures the creation of the vertices for rounded boxes
+    and color transitions for the color policies of QskBoxRectangleNode.
+
+    The results are written to stdout - or a file - as text or JSON,
+    so that they can be compared between different commits.
+ */
+
+int main( int argc, char* argv[] )
+{
+    // running headless, unless a platform has been requested explicitly
+    if ( !qEnvironmentVariableIsSet( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QQuickWindow::setSceneGraphBackend( QStringLiteral( "software" ) );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "QSkinny layout and renderer benchmarks" );
+    parser.addHelpOption();
+
+    const QCommandLineOption jsonOption( "json", "Write the results as JSON" );
+    parser.addOption( jsonOption );
+
+    const QCommandLineOption iterationsOption( "iterations",
+        "Number of iterations for each operation", "count", "10" );
+    parser.addOption( iterationsOption );
+
+    const QCommandLineOption maxOption( "max",
+        "Maximum number of items of a scenario", "count", "10000" );
+    parser.addOption( maxOption );
+
+    const QCommandLineOption outputOption( "output",
+        "Write the results to a file instead of stdout", "file" );
+    parser.addOption( outputOption );
+
+    parser.process( app );
+
+    const int iterations = qMax( 1, parser.value( iterationsOption ).toInt() );
+    const int maxCount = parser.value( maxOption ).toInt();
+
+    Benchmark::Report report;
+
+    for ( const int dimension : { 10, 32, 100 } )
+    {
+        if ( dimension * dimension <= maxCount )
+        {
+            GridBenchmark benchmark( dimension, dimension );
+            benchmark.run( report, iterations );
+        }
+    }
+
+    for ( const int count : { 100, 1000, 10000 } )
+    {
+        if ( count <= maxCount )
+        {
+            for ( const auto orientation : { Qt::Horizontal, Qt::Vertical } )
+            {
+                LinearBenchmark benchmark( orientation, count );
+                benchmark.run( report, iterations );
+            }
+
+            LinearBenchmark benchmark( Qt::Horizontal, count, 10 );
+            benchmark.run( report, iterations );
+        }
+    }
+
+    for ( const auto type : { PolishBenchmark::Linear, PolishBenchmark::Grid } )
+    {
+        for ( const int count : { 100, 1000, 10000 } )
+        {
+            if ( count > maxCount )
+                continue;
+
+            for ( const int depth : { 1, 3, 10 } )
+            {
+                PolishBenchmark benchmark( type, count, depth );
+                benchmark.run( report, iterations );
+            }
+        }
+    }
+
+    for ( const int count : { 100, 1000, 10000 } )
+    {
+        if ( count <= maxCount )
+        {
+            BoxBenchmark benchmark( count );
+            benchmark.run( report, iterations );
+        }
+    }
+
+    const auto result = parser.isSet( jsonOption )
+        ? report.toJson() : report.toText();
+
+    if ( parser.isSet( outputOption ) )
+    {
+        QFile file( parser.value( outputOption ) );
+        if ( !file.open( QIODevice::WriteOnly ) )
+        {
+            qWarning() << "Can't write to" << file.fileName();
+            return 1;
+        }
+
+        file.write( result );
+    }
+    else
+    {
+        QFile file;
+        if ( file.open( stdout, QIODevice::WriteOnly ) )
+            file.write( result );
+    }
+
+    return 0;
+}
@@ -32,8 +32,14 @@ class QSK_EXPORT QskBoxBorderColors
     QskBoxBorderColors( const QColor& );
     QskBoxBorderColors( const QskGradient& );
 
+    QskBoxBorderColors( const QskBoxBorderColors& ) = default;
+    QskBoxBorderColors( QskBoxBorderColors&& ) noexcept = default;
+
     ~QskBoxBorderColors();
 
+    QskBoxBorderColors& operator=( const QskBoxBorderColors& ) = default;
+    QskBoxBorderColors& operator=( QskBoxBorderColors&& ) noexcept = default;
+
     bool operator==( const QskBoxBorderColors& ) const;
     bool operator!=( const QskBoxBorderColors& ) const;
 
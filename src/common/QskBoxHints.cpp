@@ -33,13 +33,18 @@ QskBoxHints QskBoxHints::toAbsolute( const QSizeF& size ) const noexcept
 QskBoxHints QskBoxHints::interpolated(
     const QskBoxHints& to, qreal value ) const noexcept
 {
-    return QskBoxHints(
-        shape.interpolated( to.shape, value ),
-        borderMetrics.interpolated( to.borderMetrics, value ),
-        borderColors.interpolated( to.borderColors, value ),
-        gradient.interpolated( to.gradient, value ),
-        shadowMetrics.interpolated( to.shadowMetrics, value ),
-        QskRgb::interpolated( shadowColor, to.shadowColor, value ) );
+    // moving the interpolated values instead of copying them
+
+    QskBoxHints hints;
+
+    hints.shape = shape.interpolated( to.shape, value );
+    hints.borderMetrics = borderMetrics.interpolated( to.borderMetrics, value );
+    hints.borderColors = borderColors.interpolated( to.borderColors, value );
+    hints.gradient = gradient.interpolated( to.gradient, value );
+    hints.shadowMetrics = shadowMetrics.interpolated( to.shadowMetrics, value );
+    hints.shadowColor = QskRgb::interpolated( shadowColor, to.shadowColor, value );
+
+    return hints;
 }
 
 #ifndef QT_NO_DEBUG_STREAM
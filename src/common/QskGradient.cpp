@@ -25,18 +25,20 @@ static void qskRegisterGradient()
 
 Q_CONSTRUCTOR_FUNCTION( qskRegisterGradient )
 
-static inline bool qskIsGradientValid( const QskGradientStops& stops )
+static constexpr int qskInlineCapacity = 3;
+
+static inline bool qskIsGradientValid( const QskGradientStop* stops, int count )
 {
-    if ( stops.isEmpty() )
+    if ( count == 0 )
         return false;
 
-    if ( stops.first().position() < 0.0 || stops.last().position() > 1.0 )
+    if ( stops[ 0 ].position() < 0.0 || stops[ count - 1 ].position() > 1.0 )
         return false;
 
-    if ( !stops.first().color().isValid() )
+    if ( !stops[ 0 ].color().isValid() )
         return false;
 
-    for ( int i = 1; i < stops.size(); i++ )
+    for ( int i = 1; i < count; i++ )
     {
         if ( stops[ i ].position() < stops[ i - 1 ].position() )
             return false;
@@ -48,6 +50,56 @@ static inline bool qskIsGradientValid( const QskGradientStops& stops )
     return true;
 }
 
+static inline bool qskIsMonochrome( const QskGradientStop* stops, int count )
+{
+    for ( int i = 1; i < count; i++ )
+    {
+        if ( stops[ i ].color() != stops[ 0 ].color() )
+            return false;
+    }
+
+    return true;
+}
+
+static inline bool qskIsVisible( const QskGradientStop* stops, int count )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto& c = stops[ i ].color();
+        if ( c.isValid() && c.alpha() > 0 )
+            return true;
+    }
+
+    return false;
+}
+
+static inline bool qskHasSamePositions( const QskGradientStop* stops1,
+    const QskGradientStop* stops2, int count )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( stops1[ i ].position() != stops2[ i ].position() )
+            return false;
+    }
+
+    return true;
+}
+
+static inline bool qskIsEqual( const QskGradientStop* stops1, int count1,
+    const QskGradientStop* stops2, int count2 )
+{
+    if ( count1 != count2 )
+        return false;
+
+    for ( int i = 0; i < count1; i++ )
+    {
+        if ( stops1[i] != stops2[i] )
+            return false;
+    }
+
+    return true;
+}
+
 static inline bool qskCanBeInterpolated( const QskGradient& from, const QskGradient& to )
 {
     if ( from.isMonochrome() || to.isMonochrome() )
@@ -169,21 +221,44 @@ QskGradient::QskGradient( const QGradient& qGradient )
 }
 
 QskGradient::QskGradient( const QskGradient& other ) noexcept
-    : m_stops( other.m_stops )
+    : m_inlineStops{ other.m_inlineStops[0],
+        other.m_inlineStops[1], other.m_inlineStops[2] }
+    , m_stops( other.m_stops )
+    , m_values{ other.m_values[0], other.m_values[1],
+        other.m_values[2], other.m_values[3], other.m_values[4] }
+    , m_type( other.m_type )
+    , m_spreadMode( other.m_spreadMode )
+    , m_stretchMode( other.m_stretchMode )
+    , m_inlineCount( other.m_inlineCount )
+    , m_isDirty( other.m_isDirty )
+    , m_isValid( other.m_isValid )
+    , m_isMonchrome( other.m_isMonchrome )
+    , m_isVisible( other.m_isVisible )
+{
+}
+
+QskGradient::QskGradient( QskGradient&& other ) noexcept
+    : m_inlineStops{ other.m_inlineStops[0],
+        other.m_inlineStops[1], other.m_inlineStops[2] }
+    , m_stops( std::move( other.m_stops ) )
     , m_values{ other.m_values[0], other.m_values[1],
         other.m_values[2], other.m_values[3], other.m_values[4] }
     , m_type( other.m_type )
     , m_spreadMode( other.m_spreadMode )
     , m_stretchMode( other.m_stretchMode )
+    , m_inlineCount( other.m_inlineCount )
     , m_isDirty( other.m_isDirty )
     , m_isValid( other.m_isValid )
     , m_isMonchrome( other.m_isMonchrome )
     , m_isVisible( other.m_isVisible )
 {
+    // the stops might have been moved away
+    other.m_isDirty = true;
 }
 
 QskGradient::~QskGradient()
 {
+    delete m_inlineVector.loadRelaxed();
 }
 
 QskGradient& QskGradient::operator=( const QskGradient& other ) noexcept
@@ -191,8 +266,43 @@ QskGradient& QskGradient::operator=( const QskGradient& other ) noexcept
     m_type = other.m_type;
     m_spreadMode = other.m_spreadMode;
     m_stretchMode = other.m_stretchMode;
+
+    for ( int i = 0; i < other.m_inlineCount; i++ )
+        m_inlineStops[i] = other.m_inlineStops[i];
+
+    m_inlineCount = other.m_inlineCount;
     m_stops = other.m_stops;
 
+    resetInlineVector();
+
+    m_values[0] = other.m_values[0];
+    m_values[1] = other.m_values[1];
+    m_values[2] = other.m_values[2];
+    m_values[3] = other.m_values[3];
+    m_values[4] = other.m_values[4];
+
+    m_isDirty = other.m_isDirty;
+    m_isValid = other.m_isValid;
+    m_isMonchrome = other.m_isMonchrome;
+    m_isVisible = other.m_isVisible;
+
+    return *this;
+}
+
+QskGradient& QskGradient::operator=( QskGradient&& other ) noexcept
+{
+    m_type = other.m_type;
+    m_spreadMode = other.m_spreadMode;
+    m_stretchMode = other.m_stretchMode;
+
+    for ( int i = 0; i < other.m_inlineCount; i++ )
+        m_inlineStops[i] = other.m_inlineStops[i];
+
+    m_inlineCount = other.m_inlineCount;
+    m_stops = std::move( other.m_stops );
+
+    resetInlineVector();
+
     m_values[0] = other.m_values[0];
     m_values[1] = other.m_values[1];
     m_values[2] = other.m_values[2];
@@ -204,6 +314,9 @@ QskGradient& QskGradient::operator=( const QskGradient& other ) noexcept
     m_isMonchrome = other.m_isMonchrome;
     m_isVisible = other.m_isVisible;
 
+    // the stops might have been moved away
+    other.m_isDirty = true;
+
     return *this;
 }
 
@@ -217,18 +330,21 @@ bool QskGradient::operator==( const QskGradient& other ) const noexcept
            && ( m_values[2] == other.m_values[2] )
            && ( m_values[3] == other.m_values[3] )
            && ( m_values[4] == other.m_values[4] )
-           && ( m_stops == other.m_stops );
+           && qskIsEqual( stopData(), stopCount(), other.stopData(), other.stopCount() );
 }
 
 void QskGradient::updateStatusBits() const
 {
+    const auto stops = stopData();
+    const auto count = stopCount();
+
     // doing all bits in one loop ?
-    m_isValid = qskIsGradientValid( m_stops );
+    m_isValid = qskIsGradientValid( stops, count );
 
     if ( m_isValid )
     {
-        m_isMonchrome = qskIsMonochrome( m_stops );
-        m_isVisible = qskIsVisible( m_stops );
+        m_isMonchrome = qskIsMonochrome( stops, count );
+        m_isVisible = qskIsVisible( stops, count );
     }
     else
     {
@@ -291,18 +407,75 @@ bool QskGradient::isVisible() const noexcept
     return m_isVisible;
 }
 
-void QskGradient::setStops( const QColor& color )
+const QskGradientStops& QskGradient::stops() const noexcept
 {
-    m_stops = { { 0.0, color }, { 1.0, color } };
+    if ( m_inlineCount == 0 )
+        return m_stops;
+
+    /*
+        For inline stops the vector is created on demand. As the same
+        gradient might be read from the GUI and the scene graph thread it is
+        published atomically. Code, that runs for each frame, better uses
+        stopCount()/stopData() instead.
+     */
+
+    auto stops = m_inlineVector.loadAcquire();
+    if ( stops == nullptr )
+    {
+        auto newStops = new QskGradientStops(
+            m_inlineStops, m_inlineStops + m_inlineCount );
+
+        if ( m_inlineVector.testAndSetOrdered( nullptr, newStops, stops ) )
+            stops = newStops;
+        else
+            delete newStops;
+    }
+
+    return *stops;
+}
+
+void QskGradient::resetInlineVector()
+{
+    delete m_inlineVector.fetchAndStoreRelaxed( nullptr );
+}
+
+QskGradientStop* QskGradient::mutableStopData()
+{
+    resetInlineVector();
     m_isDirty = true;
+
+    if ( m_inlineCount )
+        return m_inlineStops;
+
+    return m_stops.data();
 }
 
-void QskGradient::setStops( const QColor& color1, const QColor& color2 )
+void QskGradient::setInlineStops( const QskGradientStop* stops, int count )
 {
-    m_stops = { { 0.0, color1 }, { 1.0, color2 } };
+    Q_ASSERT( count > 0 && count <= qskInlineCapacity );
+
+    for ( int i = 0; i < count; i++ )
+        m_inlineStops[i] = stops[i];
+
+    m_inlineCount = count;
+    m_stops = QskGradientStops();
+
+    resetInlineVector();
     m_isDirty = true;
 }
 
+void QskGradient::setStops( const QColor& color )
+{
+    const QskGradientStop stops[] = { { 0.0, color }, { 1.0, color } };
+    setInlineStops( stops, 2 );
+}
+
+void QskGradient::setStops( const QColor& color1, const QColor& color2 )
+{
+    const QskGradientStop stops[] = { { 0.0, color1 }, { 1.0, color2 } };
+    setInlineStops( stops, 2 );
+}
+
 void QskGradient::setStops( QGradient::Preset preset )
 {
     const auto stops = qskBuildGradientStops( QGradient( preset ).stops() );
@@ -311,16 +484,33 @@ void QskGradient::setStops( QGradient::Preset preset )
 
 void QskGradient::setStops( const QskGradientStops& stops )
 {
-    if ( !stops.isEmpty() && !qskIsGradientValid( stops ) )
+    const auto count = static_cast< int >( stops.count() );
+
+    if ( count > 0 && !qskIsGradientValid( stops.constData(), count ) )
     {
         qWarning( "Invalid gradient stops" );
-        m_stops.clear();
+
+        m_inlineCount = 0;
+        m_stops = QskGradientStops();
     }
     else
     {
-        m_stops = stops;
+        if ( count <= qskInlineCapacity )
+        {
+            for ( int i = 0; i < count; i++ )
+                m_inlineStops[i] = stops[i];
+
+            m_inlineCount = count;
+            m_stops = QskGradientStops();
+        }
+        else
+        {
+            m_inlineCount = 0;
+            m_stops = stops;
+        }
     }
 
+    resetInlineVector();
     m_isDirty = true;
 }
 
@@ -329,12 +519,15 @@ int QskGradient::stepCount() const noexcept
     if ( !isValid() )
         return 0;
 
-    auto steps = static_cast< int >( m_stops.count() ) - 1;
+    const auto stops = stopData();
+    const auto count = stopCount();
 
-    if ( m_stops.first().position() > 0.0 )
+    auto steps = count - 1;
+
+    if ( stops[ 0 ].position() > 0.0 )
         steps++;
 
-    if ( m_stops.last().position() < 1.0 )
+    if ( stops[ count - 1 ].position() < 1.0 )
         steps++;
 
     return steps;
@@ -342,21 +535,23 @@ int QskGradient::stepCount() const noexcept
 
 qreal QskGradient::stopAt( int index ) const noexcept
 {
-    if ( index < 0 || index >= m_stops.size() )
+    if ( index < 0 || index >= stopCount() )
         return -1.0;
 
-    return m_stops[ index ].position();
+    return stopData()[ index ].position();
 }
 
 bool QskGradient::hasStopAt( qreal value ) const noexcept
 {
+    const auto stops = stopData();
+
     // better use binary search TODO ...
-    for ( auto& stop : m_stops )
+    for ( int i = 0; i < stopCount(); i++ )
     {
-        if ( stop.position() == value )
+        if ( stops[i].position() == value )
             return true;
 
-        if ( stop.position() > value )
+        if ( stops[i].position() > value )
             break;
     }
 
@@ -365,25 +560,26 @@ bool QskGradient::hasStopAt( qreal value ) const noexcept
 
 QColor QskGradient::colorAt( int index ) const noexcept
 {
-    if ( index >= m_stops.size() )
+    if ( index < 0 || index >= stopCount() )
         return QColor();
 
-    return m_stops[ index ].color();
+    return stopData()[ index ].color();
 }
 
 void QskGradient::setAlpha( int alpha )
 {
-    for ( auto& stop : m_stops )
+    const auto count = stopCount();
+    auto stops = mutableStopData();
+
+    for ( int i = 0; i < count; i++ )
     {
-        auto c = stop.color();
+        auto c = stops[i].color();
         if ( c.isValid() && c.alpha() )
         {
             c.setAlpha( alpha );
-            stop.setColor( c );
+            stops[i].setColor( c );
         }
     }
-
-    m_isDirty = true;
 }
 
 void QskGradient::setSpreadMode( SpreadMode spreadMode )
@@ -473,9 +669,12 @@ void QskGradient::reverse()
     if ( isMonochrome() )
         return;
 
-    std::reverse( m_stops.begin(), m_stops.end() );
-    for( auto& stop : m_stops )
-        stop.setPosition( 1.0 - stop.position() );
+    const auto count = stopCount();
+    auto stops = mutableStopData();
+
+    std::reverse( stops, stops + count );
+    for( int i = 0; i < count; i++ )
+        stops[i].setPosition( 1.0 - stops[i].position() );
 }
 
 QskGradient QskGradient::reversed() const
@@ -499,13 +698,14 @@ QskGradient QskGradient::extracted( qreal from, qreal to ) const
         from = qMax( from, 0.0 );
         to = qMin( to, 1.0 );
 
-        const auto color = m_stops.first().color();
+        const auto color = startColor();
 
-        gradient.setStops( { { from, color }, { to, color } } );
+        const QskGradientStop stops[] = { { from, color }, { to, color } };
+        gradient.setInlineStops( stops, 2 );
     }
     else
     {
-        gradient.setStops( qskExtractedGradientStops( m_stops, from, to ) );
+        gradient.setStops( qskExtractedGradientStops( stops(), from, to ) );
     }
 
     return gradient;
@@ -524,10 +724,38 @@ QskGradient QskGradient::interpolated( const QskGradient& to, qreal ratio ) cons
 
         gradient = to;
 
-        const auto stops = qskInterpolatedGradientStops(
-            m_stops, isMonochrome(), to.m_stops, to.isMonochrome(), ratio );
+        const auto count = stopCount();
 
-        gradient.setStops( stops );
+        if ( isValid() && to.isValid() && isMonochrome() && to.isMonochrome() )
+        {
+            const auto c = QskRgb::interpolated( startColor(), to.startColor(), ratio );
+            gradient.setStops( c );
+        }
+        else if ( ( count == to.stopCount() ) && ( count <= qskInlineCapacity )
+            && qskHasSamePositions( stopData(), to.stopData(), count ) )
+        {
+            // no need to create a vector of stops
+
+            QskGradientStop stops[ qskInlineCapacity ];
+
+            for ( int i = 0; i < count; i++ )
+            {
+                const auto& s1 = stopData()[i];
+                const auto& s2 = to.stopData()[i];
+
+                stops[i].setStop( s1.position(),
+                    QskRgb::interpolated( s1.color(), s2.color(), ratio ) );
+            }
+
+            gradient.setInlineStops( stops, count );
+        }
+        else
+        {
+            const auto stops = qskInterpolatedGradientStops(
+                this->stops(), isMonochrome(), to.stops(), to.isMonochrome(), ratio );
+
+            gradient.setStops( stops );
+        }
 
         for ( uint i = 0; i < sizeof( m_values ) / sizeof( m_values[0] ); i++ )
             gradient.m_values[i] = m_values[i] + ratio * ( to.m_values[i] - m_values[i] );
@@ -549,14 +777,14 @@ QskGradient QskGradient::interpolated( const QskGradient& to, qreal ratio ) cons
             const auto r = 2.0 * ratio;
 
             gradient = *this;
-            gradient.setStops( qskInterpolatedGradientStops( m_stops, c, r ) );
+            gradient.setStops( qskInterpolatedGradientStops( stops(), c, r ) );
         }
         else
         {
             const auto r = 2.0 * ( ratio - 0.5 );
 
             gradient = to;
-            gradient.setStops( qskInterpolatedGradientStops( c, to.m_stops, r ) );
+            gradient.setStops( qskInterpolatedGradientStops( c, to.stops(), r ) );
         }
     }
 
@@ -571,9 +799,12 @@ QVariant QskGradient::interpolate(
 
 void QskGradient::clearStops()
 {
-    if ( !m_stops.isEmpty() )
+    if ( stopCount() > 0 )
     {
-        m_stops.clear();
+        m_inlineCount = 0;
+        m_stops = QskGradientStops();
+
+        resetInlineVector();
         m_isDirty = true;
     }
 }
@@ -587,8 +818,10 @@ QskHashValue QskGradient::hash( QskHashValue seed ) const
     if ( m_type != Stops )
         hash = qHashBits( m_values, sizeof( m_values ), hash );
 
-    for ( const auto& stop : m_stops )
-        hash = stop.hash( hash );
+    const auto stops = stopData();
+
+    for ( int i = 0; i < stopCount(); i++ )
+        hash = stops[i].hash( hash );
 
     return hash;
 }
@@ -772,7 +1005,7 @@ QGradient QskGradient::toQGradient() const
         ? QGradient::LogicalMode : QGradient::ObjectMode );
 
     g.setSpread( static_cast< QGradient::Spread >( m_spreadMode ) );
-    g.setStops( qskToQGradientStops( m_stops ) );
+    g.setStops( qskToQGradientStops( stops() ) );
 
     return g;
 }
@@ -831,7 +1064,7 @@ QDebug operator<<( QDebug debug, const QskGradient& gradient )
         }
     }
 
-    if ( !gradient.stops().isEmpty() )
+    if ( gradient.stopCount() > 0 )
     {
         if ( gradient.isMonochrome() )
         {
@@ -842,8 +1075,8 @@ QDebug operator<<( QDebug debug, const QskGradient& gradient )
         {
             debug << " ( ";
 
-            const auto& stops = gradient.stops();
-            for ( int i = 0; i < stops.count(); i++ )
+            const auto stops = gradient.stopData();
+            for ( int i = 0; i < gradient.stopCount(); i++ )
             {
                 if ( i != 0 )
                     debug << ", ";
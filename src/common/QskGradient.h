@@ -8,6 +8,7 @@
 
 #include "QskGradientStop.h"
 
+#include <qatomic.h>
 #include <qbrush.h>
 #include <qmetatype.h>
 
@@ -77,10 +78,12 @@ class QSK_EXPORT QskGradient
     QskGradient( const QGradient& );
 
     QskGradient( const QskGradient& ) noexcept;
+    QskGradient( QskGradient&& ) noexcept;
 
     ~QskGradient();
 
     QskGradient& operator=( const QskGradient& ) noexcept;
+    QskGradient& operator=( QskGradient&& ) noexcept;
 
     bool operator==( const QskGradient& ) const noexcept;
     bool operator!=( const QskGradient& ) const noexcept;
@@ -162,9 +165,16 @@ class QSK_EXPORT QskGradient
 
     QskHashValue hash( QskHashValue seed = 0 ) const;
 
+    Q_INVOKABLE int stopCount() const noexcept;
     Q_INVOKABLE qreal stopAt( int index ) const noexcept;
     Q_INVOKABLE QColor colorAt( int index ) const noexcept;
 
+    /*
+        The stops without creating a QskGradientStops for gradients
+        with inline stops. The pointer is valid until the gradient gets modified.
+     */
+    const QskGradientStop* stopData() const noexcept;
+
     int stepCount() const noexcept;
 
     QGradient toQGradient() const;
@@ -172,9 +182,22 @@ class QSK_EXPORT QskGradient
   private:
     void updateStatusBits() const;
 
+    QskGradientStop* mutableStopData();
+    void resetInlineVector();
+
+    void setInlineStops( const QskGradientStop*, int count );
+
   private:
+    /*
+        Gradients with up to 3 stops - f.e. all monochrome gradients - are
+        stored without any heap allocation. For those m_stops is empty and
+        the vector is only created, when being requested by stops().
+     */
+    QskGradientStop m_inlineStops[ 3 ];
     QskGradientStops m_stops;
 
+    mutable QAtomicPointer< QskGradientStops > m_inlineVector;
+
     /*
         Linear: x1, y1, x2, y2
         Radial: centerX, centerY, radiusX, radiusY
@@ -185,6 +208,7 @@ class QSK_EXPORT QskGradient
     unsigned int m_type : 3;
     unsigned int m_spreadMode : 3;
     unsigned int m_stretchMode : 3;
+    unsigned int m_inlineCount : 2;
 
     mutable bool m_isDirty : 1;
     mutable bool m_isValid : 1;
@@ -198,6 +222,7 @@ inline QskGradient::QskGradient() noexcept
     : m_type( Stops )
     , m_spreadMode( PadSpread )
     , m_stretchMode( StretchToSize )
+    , m_inlineCount( 0 )
     , m_isDirty( false )
     , m_isValid( false )
     , m_isMonchrome( true )
@@ -225,18 +250,14 @@ inline QskGradient::Type QskGradient::type() const noexcept
     return static_cast< Type >( m_type );
 }
 
-inline const QskGradientStops& QskGradient::stops() const noexcept
+inline int QskGradient::stopCount() const noexcept
 {
-#if 1
-    /*
-        Returning a const& so that it is possible to write:
-            for ( const auto& stop : qAsConst( gradient.stops() ) )
+    return m_inlineCount ? int( m_inlineCount ) : int( m_stops.count() );
+}
 
-        Once we have changed QskGradientStop from QColor to QRgb
-        we should check if there is a better solution possible
-     */
-#endif
-    return m_stops;
+inline const QskGradientStop* QskGradient::stopData() const noexcept
+{
+    return m_inlineCount ? m_inlineStops : m_stops.constData();
 }
 
 inline void QskGradient::setStops( QRgb rgb )
@@ -251,22 +272,26 @@ inline void QskGradient::setStops( Qt::GlobalColor color )
 
 inline QColor QskGradient::startColor() const noexcept
 {
-    return m_stops.isEmpty() ? QColor() : m_stops.first().color();
+    const auto n = stopCount();
+    return ( n == 0 ) ? QColor() : stopData()[ 0 ].color();
 }
 
 inline QColor QskGradient::endColor() const noexcept
 {
-    return m_stops.isEmpty() ? QColor() : m_stops.last().color();
+    const auto n = stopCount();
+    return ( n == 0 ) ? QColor() : stopData()[ n - 1 ].color();
 }
 
 inline QRgb QskGradient::rgbStart() const
 {
-    return m_stops.isEmpty() ? qRgba( 0, 0, 0, 255 ) : m_stops.first().rgb();
+    const auto n = stopCount();
+    return ( n == 0 ) ? qRgba( 0, 0, 0, 255 ) : stopData()[ 0 ].rgb();
 }
 
 inline QRgb QskGradient::rgbEnd() const
 {
-    return m_stops.isEmpty() ? qRgba( 0, 0, 0, 255 ) : m_stops.last().rgb();
+    const auto n = stopCount();
+    return ( n == 0 ) ? qRgba( 0, 0, 0, 255 ) : stopData()[ n - 1 ].rgb();
 }
 
 inline QskGradient::SpreadMode QskGradient::spreadMode() const noexcept
@@ -6,9 +6,17 @@
 #include "QskObjectCounter.h"
 
 #include <qdebug.h>
+#include <qmutex.h>
 #include <qset.h>
 #include <qobject.h>
 #include <qcoreapplication.h>
+#include <qguiapplication.h>
+#include <qquickwindow.h>
+#include <qsgnode.h>
+#include <qsgtexture.h>
+#include <qsgtexturematerial.h>
+
+#include <algorithm>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qhooks_p.h>
@@ -34,6 +42,58 @@ static inline bool qskIsItem( const QObject* object )
     return dynamic_cast< QQuickItemPrivate* >( o_p ) != nullptr;
 }
 
+static void qskCountNodes( const QSGNode* node,
+    QskObjectCounter::ClassStatistics& statistics, QSet< const QSGTexture* >& textures )
+{
+    statistics.nodes++;
+
+    if ( node->type() == QSGNode::GeometryNodeType )
+    {
+        auto geometryNode = static_cast< const QSGGeometryNode* >( node );
+
+        if ( auto geometry = geometryNode->geometry() )
+        {
+            statistics.geometryBytes +=
+                qint64( geometry->vertexCount() ) * geometry->sizeOfVertex()
+                + qint64( geometry->indexCount() ) * geometry->sizeOfIndex();
+        }
+
+        auto material = dynamic_cast< const QSGOpaqueTextureMaterial* >(
+            geometryNode->material() );
+
+        if ( material && material->texture() )
+        {
+            const auto texture = material->texture();
+
+            // textures might be shared
+            if ( !textures.contains( texture ) )
+            {
+                textures.insert( texture );
+
+                const auto size = texture->textureSize();
+
+                statistics.textures++;
+                statistics.textureBytes += 4 * qint64( size.width() ) * size.height();
+            }
+        }
+    }
+
+    for ( auto child = node->firstChild(); child; child = child->nextSibling() )
+        qskCountNodes( child, statistics, textures );
+}
+
+static void qskCountItemNodes( const QQuickItem* item,
+    QskObjectCounter::Snapshot& snapshot, QSet< const QSGTexture* >& textures )
+{
+    // the child items are not below the paint node
+    if ( auto node = QQuickItemPrivate::get( item )->paintNode )
+        qskCountNodes( node, snapshot.classes[ item->metaObject() ], textures );
+
+    const auto children = QQuickItemPrivate::get( item )->childItems;
+    for ( auto child : children )
+        qskCountItemNodes( child, snapshot, textures );
+}
+
 namespace
 {
     class Counter
@@ -75,6 +135,18 @@ namespace
       public:
         Counter counter[ 2 ];
 
+        /*
+            The meta object is resolved lazily, as the object
+            is not constructed, when being added.
+
+            Objects are created and destroyed in any thread - f.e. the
+            scene graph thread - so the table is guarded by a mutex.
+         */
+        QHash< const QObject*, const QMetaObject* > classTable;
+        QMutex classMutex;
+
+        bool hasClassStatistics = false;
+
 #if QSK_OBJECT_INFO
         QSet< const QObject* > objectTable;
 #endif
@@ -169,6 +241,12 @@ void CounterHook::addObject( QObject* object )
         if ( isItem )
             counterData->counter[ QskObjectCounter::Items ].increment();
 
+        if ( counterData->hasClassStatistics )
+        {
+            QMutexLocker locker( &counterData->classMutex );
+            counterData->classTable.insert( object, nullptr );
+        }
+
 #if QSK_OBJECT_INFO
         counterData->objectTable.insert( object );
 #endif
@@ -189,6 +267,12 @@ void CounterHook::removeObject( QObject* object )
         if ( isItem )
             counterData->counter[ QskObjectCounter::Items ].decrement();
 
+        if ( counterData->hasClassStatistics )
+        {
+            QMutexLocker locker( &counterData->classMutex );
+            counterData->classTable.remove( object );
+        }
+
 #if QSK_OBJECT_INFO
         counterData->objectTable.remove( object );
 #endif
@@ -297,6 +381,92 @@ void QskObjectCounter::reset()
     counters[ Items ].reset();
 }
 
+void QskObjectCounter::setClassStatisticsEnabled( bool on )
+{
+    auto& counterData = m_data->counterData;
+
+    if ( on != counterData.hasClassStatistics )
+    {
+        QMutexLocker locker( &counterData.classMutex );
+
+        counterData.hasClassStatistics = on;
+        counterData.classTable.clear();
+    }
+}
+
+bool QskObjectCounter::isClassStatisticsEnabled() const
+{
+    return m_data->counterData.hasClassStatistics;
+}
+
+QskObjectCounter::Snapshot QskObjectCounter::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.objects = current( Objects );
+    snapshot.items = current( Items );
+
+    {
+        auto& counterData = m_data->counterData;
+        QMutexLocker locker( &counterData.classMutex );
+
+        auto& classTable = counterData.classTable;
+        for ( auto it = classTable.begin(); it != classTable.end(); ++it )
+        {
+            if ( it.value() == nullptr )
+                it.value() = it.key()->metaObject();
+
+            snapshot.classes[ it.value() ].instances++;
+        }
+    }
+
+    if ( qobject_cast< QGuiApplication* >( QCoreApplication::instance() ) )
+    {
+        QSet< const QSGTexture* > textures;
+
+        const auto windows = QGuiApplication::allWindows();
+        for ( auto window : windows )
+        {
+            if ( auto quickWindow = qobject_cast< const QQuickWindow* >( window ) )
+                qskCountItemNodes( quickWindow->contentItem(), snapshot, textures );
+        }
+    }
+
+    return snapshot;
+}
+
+QskObjectCounter::Snapshot QskObjectCounter::difference(
+    const Snapshot& from, const Snapshot& to )
+{
+    Snapshot diff;
+    diff.objects = to.objects - from.objects;
+    diff.items = to.items - from.items;
+
+    auto classes = to.classes.keys();
+    for ( auto it = from.classes.constBegin(); it != from.classes.constEnd(); ++it )
+    {
+        if ( !to.classes.contains( it.key() ) )
+            classes += it.key();
+    }
+
+    for ( auto metaObject : qAsConst( classes ) )
+    {
+        const auto s1 = from.classes.value( metaObject );
+        const auto s2 = to.classes.value( metaObject );
+
+        ClassStatistics statistics;
+        statistics.instances = s2.instances - s1.instances;
+        statistics.nodes = s2.nodes - s1.nodes;
+        statistics.textures = s2.textures - s1.textures;
+        statistics.geometryBytes = s2.geometryBytes - s1.geometryBytes;
+        statistics.textureBytes = s2.textureBytes - s1.textureBytes;
+
+        if ( !statistics.isNull() )
+            diff.classes.insert( metaObject, statistics );
+    }
+
+    return diff;
+}
+
 int QskObjectCounter::created( ObjectType objectType ) const
 {
     return m_data->counterData.counter[ objectType ].created;
@@ -366,6 +536,12 @@ void QskObjectCounter::dump() const
     debugStatistics( debug, Items );
 }
 
+bool QskObjectCounter::ClassStatistics::isNull() const
+{
+    return ( instances == 0 ) && ( nodes == 0 ) && ( textures == 0 )
+        && ( geometryBytes == 0 ) && ( textureBytes == 0 );
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 QDebug operator<<( QDebug debug, const QskObjectCounter& counter )
@@ -374,4 +550,32 @@ QDebug operator<<( QDebug debug, const QskObjectCounter& counter )
     return debug;
 }
 
+QDebug operator<<( QDebug debug, const QskObjectCounter::Snapshot& snapshot )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "Snapshot( objects: " << snapshot.objects
+        << ", items: " << snapshot.items << ')';
+
+    auto classes = snapshot.classes.keys();
+    std::sort( classes.begin(), classes.end(),
+        []( const QMetaObject* m1, const QMetaObject* m2 )
+        { return qstrcmp( m1->className(), m2->className() ) < 0; } );
+
+    for ( auto metaObject : qAsConst( classes ) )
+    {
+        const auto& s = snapshot.classes[ metaObject ];
+
+        debug << "\n  " << metaObject->className() << ": "
+            << "instances: " << s.instances
+            << ", nodes: " << s.nodes
+            << ", geometry: " << s.geometryBytes
+            << ", textures: " << s.textures
+            << " ( " << s.textureBytes << " )";
+    }
+
+    return debug;
+}
+
 #endif
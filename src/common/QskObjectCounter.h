@@ -7,9 +7,11 @@
 #define QSK_OBJECT_COUNTER_H
 
 #include "QskGlobal.h"
+#include <qhash.h>
 #include <memory>
 
 class QObject;
+struct QMetaObject;
 
 class QSK_EXPORT QskObjectCounter
 {
@@ -20,12 +22,42 @@ class QSK_EXPORT QskObjectCounter
         Items
     };
 
+    class ClassStatistics
+    {
+      public:
+        bool isNull() const;
+
+        int instances = 0;
+
+        // scene graph resources of the items
+        int nodes = 0;
+        int textures = 0;
+        qint64 geometryBytes = 0;
+        qint64 textureBytes = 0;
+    };
+
+    class Snapshot
+    {
+      public:
+        int objects = 0;
+        int items = 0;
+
+        QHash< const QMetaObject*, ClassStatistics > classes;
+    };
+
     QskObjectCounter( bool debugAtDestruction = false );
     ~QskObjectCounter();
 
     void setActive( bool );
     bool isActive() const;
 
+    /*
+        Counting the instances per class needs a lookup table for
+        all objects, created after enabling it.
+     */
+    void setClassStatisticsEnabled( bool );
+    bool isClassStatisticsEnabled() const;
+
     void reset();
 
     int created( ObjectType = Objects ) const;
@@ -33,6 +65,16 @@ class QSK_EXPORT QskObjectCounter
     int current( ObjectType = Objects ) const;
     int maximum( ObjectType = Objects ) const;
 
+    /*
+        The scene graph resources are collected from the paint nodes of
+        all items of all QQuickWindows. This has to be done from the GUI
+        thread, when the scene graph is not being synchronized.
+     */
+    Snapshot snapshot() const;
+
+    // changes between 2 snapshots, classes without changes are omitted
+    static Snapshot difference( const Snapshot& from, const Snapshot& to );
+
     void debugStatistics( QDebug, ObjectType = Objects ) const;
     void dump() const;
 
@@ -47,6 +89,7 @@ class QSK_EXPORT QskObjectCounter
 
 class QDebug;
 QSK_EXPORT QDebug operator<<( QDebug, const QskObjectCounter& );
+QSK_EXPORT QDebug operator<<( QDebug, const QskObjectCounter::Snapshot& );
 
 #endif
 
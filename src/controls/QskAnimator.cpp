@@ -4,14 +4,18 @@
  *****************************************************************************/
 
 #include "QskAnimator.h"
+#include "QskSetup.h"
 
 #include <qelapsedtimer.h>
 #include <qglobalstatic.h>
 #include <qobject.h>
 #include <qquickwindow.h>
+#include <qtimer.h>
 #include <qvector.h>
 
 #include <cmath>
+#include <memory>
+#include <vector>
 
 #ifndef QT_NO_DEBUG_STREAM
 #include <qdebug.h>
@@ -36,7 +40,9 @@ namespace
             debug << "created: " << created
                   << ", destroyed: " << destroyed
                   << ", current: " << current
-                  << ", maximum: " << maximum;
+                  << ", maximum: " << maximum
+                  << ", advanced: " << advanced
+                  << ", maximum advanced: " << maximumAdvanced;
             debug << ')';
         }
 #endif
@@ -44,6 +50,7 @@ namespace
         inline void reset()
         {
             created = destroyed = current = maximum = 0;
+            advanced = maximumAdvanced = 0;
         }
 
         inline void increment()
@@ -61,171 +68,404 @@ namespace
             current--;
         }
 
+        inline void setAdvanced( int count )
+        {
+            advanced = count;
+
+            if ( advanced > maximumAdvanced )
+                maximumAdvanced = advanced;
+        }
+
         int created;
         int destroyed;
         int current;
         int maximum;
+
+        // animators advanced in the last frame of any window
+        int advanced;
+        int maximumAdvanced;
     };
 }
 
-namespace
+Q_GLOBAL_STATIC( Statistics, qskStatistics )
+
+/*
+    We need to have at least one QObject to connect to QQuickWindow
+    updates - but then we can advance the animators manually without
+    making them heavy QObjects too.
+ */
+class QskAnimatorDriver final : public QObject
 {
+    Q_OBJECT
+
+  public:
+    QskAnimatorDriver();
+
+    void registerAnimator( QskAnimator* );
+    void unregisterAnimator( QskAnimator* );
+
+    qint64 referenceTime() const;
+
+    int advancedCount( const QQuickWindow* ) const;
+    qreal frameRate( const QQuickWindow* ) const;
+
+  Q_SIGNALS:
+    void advanced( QQuickWindow* );
+    void terminated( QQuickWindow* );
+
+  private:
+    class Bucket;
+
+    void advanceAnimators( QQuickWindow* );
+    void removeWindow( QQuickWindow* );
+    void scheduleUpdate( QQuickWindow* );
+
+    Bucket* bucket( const QQuickWindow* ) const;
+
+    QElapsedTimer m_referenceTime;
+
     /*
-        We need to have at least one QObject to connect to QQuickWindow
-        updates - but then we can advance the animators manually without
-        making them heavy QObjects too.
+       Having a more than a very few windows with running animators is
+       very unlikely and using a hash table instead of a vector probably
+       creates more overhead than being good for something.
      */
-    class AnimatorDriver final : public QObject
+    std::vector< std::unique_ptr< Bucket > > m_buckets;
+
+    // the window, that is currently advanced
+    const QQuickWindow* m_advancingWindow = nullptr;
+};
+
+/*
+    The animators of a window, where each animator knows its
+    slot, so that registering/unregistering is O(1).
+ */
+class QskAnimatorDriver::Bucket
+{
+  public:
+    Bucket( QQuickWindow* window )
+        : window( window )
     {
-        Q_OBJECT
+        updateTimer.setSingleShot( true );
+        QObject::connect( &updateTimer, &QTimer::timeout,
+            window, &QQuickWindow::update );
+    }
 
-      public:
-        AnimatorDriver();
+    void countFrame( qint64 time )
+    {
+        if ( frameRateTime < 0 )
+            frameRateTime = time;
 
-        void registerAnimator( QskAnimator* );
-        void unregisterAnimator( QskAnimator* );
+        frameCount++;
 
-        qint64 referenceTime() const;
+        const auto elapsed = time - frameRateTime;
+        if ( elapsed >= 1000 )
+        {
+            frameRate = frameCount * 1000.0 / elapsed;
 
-      Q_SIGNALS:
-        void advanced( QQuickWindow* );
-        void terminated( QQuickWindow* );
+            frameCount = 0;
+            frameRateTime = time;
+        }
+    }
 
-      private:
-        void advanceAnimators( QQuickWindow* );
-        void removeWindow( QQuickWindow* );
-        void scheduleUpdate( QQuickWindow* );
+    inline bool contains( const QskAnimator* animator ) const
+    {
+        // copies of an animator might carry a stale slot
+        const int slot = animator->m_slot;
+        return ( slot >= 0 ) && ( slot < animators.size() )
+            && ( animators[ slot ] == animator );
+    }
 
-        QElapsedTimer m_referenceTime;
+    void append( QskAnimator* animator )
+    {
+        animator->m_slot = animators.size();
+        animators += animator;
+    }
 
-        // a sorted vector, good for iterating and good enough for look ups
-        QVector< QskAnimator* > m_animators;
+    void remove( QskAnimator* animator, bool isAdvancing )
+    {
+        const int slot = animator->m_slot;
 
-        /*
-           Having a more than a very few windows with running animators is
-           very unlikely and using a hash table instead of a vector probably
-           creates more overhead than being good for something.
-         */
-        QVector< QQuickWindow* > m_windows;
-        mutable int m_index = -1; // current value, when iterating
-    };
+        if ( isAdvancing )
+        {
+            /*
+                Moving other animators around would confuse the
+                iteration, so we leave a hole, that will be
+                removed, when advancing is done.
+             */
+            animators[ slot ] = nullptr;
+            hasHoles = true;
+        }
+        else
+        {
+            const auto last = animators.takeLast();
+            if ( slot < animators.size() )
+            {
+                animators[ slot ] = last;
+                last->m_slot = slot;
+            }
+        }
+
+        animator->m_slot = -1;
+    }
+
+    void clear( bool isAdvancing )
+    {
+        for ( auto animator : qAsConst( animators ) )
+        {
+            if ( animator )
+                animator->m_slot = -1;
+        }
+
+        if ( isAdvancing )
+        {
+            animators.fill( nullptr );
+            hasHoles = true;
+        }
+        else
+        {
+            animators.clear();
+        }
+    }
+
+    void removeHoles()
+    {
+        int count = 0;
+
+        for ( int i = 0; i < animators.size(); i++ )
+        {
+            if ( auto animator = animators[ i ] )
+            {
+                animator->m_slot = count;
+                animators[ count++ ] = animator;
+            }
+        }
+
+        animators.resize( count );
+        hasHoles = false;
+    }
+
+    QQuickWindow* const window;
+    QVector< QskAnimator* > animators;
+
+    int advancedCount = 0; // for the last frame
+    bool hasHoles = false;
+
+    // for throttling
+    qint64 lastAdvance = -1;
+    QTimer updateTimer;
+
+    // frames per second caused by the animators
+    qreal frameRate = 0.0;
+    int frameCount = 0;
+    qint64 frameRateTime = -1;
+};
+
+static inline qint64 qskFrameInterval()
+{
+    const int fps = qskSetup->animationFrameRate();
+    return ( fps > 0 ) ? qRound64( 1000.0 / fps ) : 0;
+}
+
+static inline bool qskIsThrottled( qint64 elapsed, qint64 interval )
+{
+    /*
+        Some slack to avoid missing the next vsync, when
+        the interval is a multiple of the refresh rate
+     */
+    return elapsed + 2 < interval;
 }
 
-AnimatorDriver::AnimatorDriver()
+QskAnimatorDriver::QskAnimatorDriver()
 {
     m_referenceTime.start();
 }
 
-inline qint64 AnimatorDriver::referenceTime() const
+inline qint64 QskAnimatorDriver::referenceTime() const
 {
     return m_referenceTime.elapsed();
 }
 
-void AnimatorDriver::registerAnimator( QskAnimator* animator )
+QskAnimatorDriver::Bucket* QskAnimatorDriver::bucket( const QQuickWindow* window ) const
+{
+    for ( const auto& bucket : m_buckets )
+    {
+        if ( bucket->window == window )
+            return bucket.get();
+    }
+
+    return nullptr;
+}
+
+void QskAnimatorDriver::registerAnimator( QskAnimator* animator )
 {
-    Q_ASSERT( animator->window() );
+    auto window = animator->window();
+    Q_ASSERT( window );
 
     // do we want to be thread safe ???
 
-    auto it = std::lower_bound( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() && *it == animator )
+    if ( window == nullptr )
         return;
 
-    if ( m_index > 0 )
+    auto bucket = this->bucket( window );
+    if ( bucket && bucket->contains( animator ) )
+        return;
+
+    if ( bucket == nullptr )
     {
-        if ( it - m_animators.begin() < m_index )
-            m_index++;
+        bucket = new Bucket( window );
+        m_buckets.emplace_back( bucket );
+
+        connect( window, &QQuickWindow::afterAnimating,
+            this, [ this, window ]() { advanceAnimators( window ); } );
+
+        connect( window, &QQuickWindow::frameSwapped,
+            this, [ this, window ]() { scheduleUpdate( window ); } );
+
+        connect( window, &QWindow::visibleChanged,
+            this, [ this, window ]( bool on ) { if ( !on ) removeWindow( window ); } );
+
+        connect( window, &QObject::destroyed,
+            this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+
+        window->update();
     }
 
-    m_animators.insert( it, animator );
+    bucket->append( animator );
+}
+
+void QskAnimatorDriver::scheduleUpdate( QQuickWindow* window )
+{
+    auto bucket = this->bucket( window );
+    if ( bucket == nullptr )
+        return;
 
-    if ( auto window = animator->window() )
+    const auto interval = qskFrameInterval();
+
+    if ( interval > 0 && bucket->lastAdvance >= 0 )
     {
-        if ( !m_windows.contains( window ) )
+        const auto elapsed = referenceTime() - bucket->lastAdvance;
+        if ( qskIsThrottled( elapsed, interval ) )
         {
-            m_windows += window;
+            if ( !bucket->updateTimer.isActive() )
+                bucket->updateTimer.start( int( interval - elapsed ) );
 
-            connect( window, &QQuickWindow::afterAnimating,
-                this, [ this, window ]() { advanceAnimators( window ); } );
+            return;
+        }
+    }
 
-            connect( window, &QQuickWindow::frameSwapped,
-                this, [ this, window ]() { scheduleUpdate( window ); } );
+    window->update();
+}
 
-            connect( window, &QWindow::visibleChanged,
-                this, [ this, window ]( bool on ) { if ( !on ) removeWindow( window ); } );
+void QskAnimatorDriver::removeWindow( QQuickWindow* window )
+{
+    window->disconnect( this );
 
-            connect( window, &QObject::destroyed,
-                this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+    for ( auto it = m_buckets.begin(); it != m_buckets.end(); ++it )
+    {
+        if ( ( *it )->window == window )
+        {
+            if ( window == m_advancingWindow )
+            {
+                // advanceAnimators is on the stack: keep the bucket alive
+                ( *it )->clear( true );
+            }
+            else
+            {
+                ( *it )->clear( false );
+                m_buckets.erase( it );
+            }
 
-            window->update();
+            break;
         }
     }
 }
 
-void AnimatorDriver::scheduleUpdate( QQuickWindow* window )
+void QskAnimatorDriver::unregisterAnimator( QskAnimator* animator )
 {
-    if ( m_windows.contains( window ) )
-        window->update();
+    if ( animator->m_slot < 0 )
+        return;
+
+    auto bucket = this->bucket( animator->window() );
+    if ( bucket && bucket->contains( animator ) )
+        bucket->remove( animator, bucket->window == m_advancingWindow );
+    else
+        animator->m_slot = -1;
 }
 
-void AnimatorDriver::removeWindow( QQuickWindow* window )
+int QskAnimatorDriver::advancedCount( const QQuickWindow* window ) const
 {
-    window->disconnect( this );
-    m_windows.removeOne( window );
+    const auto bucket = this->bucket( window );
+    return bucket ? bucket->advancedCount : 0;
+}
 
-    for ( auto it = m_animators.begin(); it != m_animators.end(); )
-    {
-        if ( ( *it )->window() == window )
-            it = m_animators.erase( it );
-        else
-            ++it;
-    }
+qreal QskAnimatorDriver::frameRate( const QQuickWindow* window ) const
+{
+    const auto bucket = this->bucket( window );
+    return bucket ? bucket->frameRate : 0.0;
 }
 
-void AnimatorDriver::unregisterAnimator( QskAnimator* animator )
+void QskAnimatorDriver::advanceAnimators( QQuickWindow* window )
 {
-    auto it = std::find( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() )
-    {
-        if ( it - m_animators.begin() < m_index )
-            m_index--;
+    auto bucket = this->bucket( window );
+    if ( bucket == nullptr )
+        return;
+
+    const auto time = referenceTime();
 
-        m_animators.erase( it );
+    if ( bucket->lastAdvance >= 0 )
+    {
+        /*
+            The window might be rendered for other reasons, but we don't
+            advance more often than being allowed. As the progress of
+            the animators depends on the time, they remain time-correct.
+         */
+        const auto interval = qskFrameInterval();
+        if ( interval > 0 && qskIsThrottled( time - bucket->lastAdvance, interval ) )
+            return;
     }
-}
 
-void AnimatorDriver::advanceAnimators( QQuickWindow* window )
-{
-    bool hasAnimators = false;
+    bucket->lastAdvance = time;
+    bucket->countFrame( time );
+
+    const auto outerWindow = m_advancingWindow;
+    m_advancingWindow = window;
+
+    int advancedCount = 0;
     bool hasTerminations = false;
 
-    for ( m_index = m_animators.size() - 1; m_index >= 0; m_index-- )
+    /*
+        Advancing animators might create/remove animators: new animators
+        are appended and not advanced before the next frame, removed animators
+        leave a hole, that is cleaned up below.
+     */
+    const auto count = bucket->animators.size();
+
+    for ( int i = 0; i < count; i++ )
     {
-        // Advancing animators might create/remove animators, what is handled by
-        // adjusting m_index in register/unregister
+        auto animator = bucket->animators[ i ];
 
-        auto animator = m_animators[ m_index ];
-        if ( animator->window() == window )
+        if ( animator && animator->isRunning() )
         {
-            hasAnimators = true;
-
-            if ( animator->isRunning() )
-            {
-                animator->update();
+            animator->update();
+            advancedCount++;
 
-                if ( !animator->isRunning() )
-                    hasTerminations = true;
-            }
+            if ( !animator->isRunning() )
+                hasTerminations = true;
         }
     }
 
-    m_index = -1;
+    m_advancingWindow = outerWindow;
 
-    if ( !hasAnimators )
-    {
-        window->disconnect( this );
-        m_windows.removeOne( const_cast< QQuickWindow* >( window ) );
-    }
+    if ( bucket->hasHoles )
+        bucket->removeHoles();
+
+    bucket->advancedCount = advancedCount;
+
+    if ( qskStatistics )
+        qskStatistics->setAdvanced( advancedCount );
+
+    if ( bucket->animators.isEmpty() )
+        removeWindow( window );
 
     Q_EMIT advanced( window );
 
@@ -233,11 +473,11 @@ void AnimatorDriver::advanceAnimators( QQuickWindow* window )
         Q_EMIT terminated( window );
 }
 
-Q_GLOBAL_STATIC( AnimatorDriver, qskAnimatorDriver )
-Q_GLOBAL_STATIC( Statistics, qskStatistics )
+Q_GLOBAL_STATIC( QskAnimatorDriver, qskAnimatorDriver )
 
 QskAnimator::QskAnimator()
     : m_window( nullptr )
+    , m_slot( -1 )
     , m_duration( 200 )
     , m_startTime( -1 )
 {
@@ -398,6 +638,22 @@ QMetaObject::Connection QskAnimator::addAdvanceHandler(
         SIGNAL(advanced(QQuickWindow*)), receiver, method, type );
 }
 
+qreal QskAnimator::frameRate( const QQuickWindow* window )
+{
+    if ( auto driver = qskAnimatorDriver )
+        return driver->frameRate( window );
+
+    return 0.0;
+}
+
+int QskAnimator::advancedCount( const QQuickWindow* window )
+{
+    if ( auto driver = qskAnimatorDriver )
+        return driver->advancedCount( window );
+
+    return 0;
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 void QskAnimator::debugStatistics( QDebug debug )
@@ -50,6 +50,12 @@ class QSK_EXPORT QskAnimator
         QObject* receiver, const char* method,
         Qt::ConnectionType type = Qt::AutoConnection );
 
+    // number of animators, that have been advanced in the last frame
+    static int advancedCount( const QQuickWindow* );
+
+    // frames per second, where animators have been advanced
+    static qreal frameRate( const QQuickWindow* );
+
 #ifndef QT_NO_DEBUG_STREAM
     static void debugStatistics( QDebug );
 #endif
@@ -60,7 +66,10 @@ class QSK_EXPORT QskAnimator
     virtual void done();
 
   private:
+    friend class QskAnimatorDriver;
+
     QQuickWindow* m_window;
+    int m_slot; // position in the list of the animators of the window
 
     int m_duration;
     QEasingCurve m_easingCurve;
@@ -0,0 +1,271 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskBatchingInspector.h"
+#include "QskSGNode.h"
+
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgmaterial.h>
+#include <qsgnode.h>
+
+#include <typeinfo>
+
+#ifdef __GNUC__
+    #include <cxxabi.h>
+    #include <cstdlib>
+#endif
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickitem_p.h>
+QSK_QT_PRIVATE_END
+
+static const char* qskMaterialName( const QSGMaterial* material )
+{
+    const char* name = typeid( *material ).name();
+
+#ifdef __GNUC__
+    /*
+        gcc/clang return mangled names. As there are only a couple
+        of material classes, the demangled names are kept forever.
+     */
+    static QMutex mutex;
+    static QHash< const char*, QByteArray > names;
+
+    QMutexLocker locker( &mutex );
+
+    auto it = names.constFind( name );
+    if ( it == names.constEnd() )
+    {
+        int status = 0;
+        auto demangled = abi::__cxa_demangle( name, nullptr, nullptr, &status );
+
+        it = names.insert( name,
+            ( status == 0 && demangled ) ? QByteArray( demangled ) : QByteArray( name ) );
+
+        std::free( demangled );
+    }
+
+    name = it->constData();
+#endif
+
+    return name;
+}
+
+namespace
+{
+    class Inspector
+    {
+      public:
+        Inspector( QskBatchingInspector::Report& report )
+            : m_report( report )
+        {
+        }
+
+        void addItems( const QQuickItem* item )
+        {
+            auto d = QQuickItemPrivate::get( item );
+
+            if ( d->paintNode )
+                m_paintNodes.insert( d->paintNode, item );
+
+            for ( auto child : d->childItems )
+                addItems( child );
+        }
+
+        void inspect( const QSGNode* node, const QQuickItem* item, quint8 role )
+        {
+            if ( auto paintItem = m_paintNodes.value( node ) )
+            {
+                item = paintItem;
+                role = QskSGNode::NoRole;
+            }
+            else if ( item && ( node->parent() == QQuickItemPrivate::get( item )->paintNode ) )
+            {
+                // the skinlets assign the roles to the children of the paint node
+                role = QskSGNode::nodeRole( node );
+            }
+
+            switch ( node->type() )
+            {
+                case QSGNode::ClipNodeType:
+                {
+                    m_isClipChanged = true;
+                    break;
+                }
+                case QSGNode::RenderNodeType:
+                {
+                    m_previousMaterial = nullptr;
+                    m_isClipChanged = true;
+                    break;
+                }
+                case QSGNode::GeometryNodeType:
+                {
+                    addGeometryNode(
+                        static_cast< const QSGGeometryNode* >( node ), item, role );
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            for ( auto child = node->firstChild(); child; child = child->nextSibling() )
+                inspect( child, item, role );
+
+            if ( node->type() == QSGNode::ClipNodeType )
+                m_isClipChanged = true;
+        }
+
+        void finish()
+        {
+            m_report.materialTypeCount = m_materials.size();
+
+            for ( const auto& materials : qAsConst( m_materials ) )
+                m_report.materialCount += materials.size();
+        }
+
+      private:
+        void addGeometryNode( const QSGGeometryNode* node,
+            const QQuickItem* item, quint8 role )
+        {
+            auto material = node->activeMaterial();
+            if ( material == nullptr )
+                return;
+
+            auto& entry = currentEntry( item, role );
+
+            const char* className = qskMaterialName( material );
+            if ( !entry.materials.contains( className ) )
+                entry.materials += className;
+
+            const int vertexCount = node->geometry() ? node->geometry()->vertexCount() : 0;
+
+            entry.nodeCount++;
+            entry.vertexCount += vertexCount;
+
+            m_report.nodeCount++;
+            m_report.vertexCount += vertexCount;
+
+            if ( m_previousMaterial == nullptr
+                || !isCompatible( material, m_previousMaterial ) || m_isClipChanged )
+            {
+                entry.batchBreaks++;
+                m_report.batchBreaks++;
+            }
+
+            m_previousMaterial = material;
+            m_isClipChanged = false;
+
+            addMaterial( material );
+        }
+
+        static bool isCompatible( const QSGMaterial* m1, const QSGMaterial* m2 )
+        {
+            return ( m1->type() == m2->type() ) && ( m1->compare( m2 ) == 0 );
+        }
+
+        void addMaterial( const QSGMaterial* material )
+        {
+            auto& materials = m_materials[ material->type() ];
+
+            for ( auto m : qAsConst( materials ) )
+            {
+                if ( m->compare( material ) == 0 )
+                    return;
+            }
+
+            materials += material;
+        }
+
+        QskBatchingInspector::Entry& currentEntry( const QQuickItem* item, quint8 role )
+        {
+            auto& entries = m_report.entries;
+
+            if ( entries.isEmpty() || entries.last().item != item
+                || entries.last().nodeRole != role )
+            {
+                QskBatchingInspector::Entry entry;
+                entry.item = item;
+                entry.nodeRole = role;
+
+                entries += entry;
+            }
+
+            return entries.last();
+        }
+
+        QskBatchingInspector::Report& m_report;
+
+        QHash< const QSGNode*, const QQuickItem* > m_paintNodes;
+
+        // materials, that can't be batched, per type
+        QHash< const QSGMaterialType*, QVector< const QSGMaterial* > > m_materials;
+
+        const QSGMaterial* m_previousMaterial = nullptr;
+        bool m_isClipChanged = false;
+    };
+}
+
+QskBatchingInspector::Report QskBatchingInspector::inspect( const QQuickWindow* window )
+{
+    Report report;
+
+    if ( window == nullptr )
+        return report;
+
+    auto contentItem = window->contentItem();
+
+    // itemNode() would create the node
+    auto rootNode = QQuickItemPrivate::get( contentItem )->itemNodeInstance;
+    if ( rootNode == nullptr )
+        return report;
+
+    Inspector inspector( report );
+    inspector.addItems( contentItem );
+    inspector.inspect( rootNode, nullptr, QskSGNode::NoRole );
+    inspector.finish();
+
+    return report;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug, const QskBatchingInspector::Report& report )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "Batching( nodes: " << report.nodeCount
+        << ", vertexes: " << report.vertexCount
+        << ", batches: " << report.batchBreaks
+        << ", material types: " << report.materialTypeCount
+        << ", materials: " << report.materialCount << " )";
+
+    for ( const auto& entry : report.entries )
+    {
+        debug << "\n  ";
+
+        if ( entry.item )
+            debug << entry.item->metaObject()->className();
+        else
+            debug << "-";
+
+        debug << " [" << int( entry.nodeRole ) << "]"
+            << " nodes: " << entry.nodeCount
+            << ", vertexes: " << entry.vertexCount
+            << ", batches: " << entry.batchBreaks
+            << ", materials:";
+
+        for ( auto material : entry.materials )
+            debug << ' ' << material;
+    }
+
+    return debug;
+}
+
+#endif
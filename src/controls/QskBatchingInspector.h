@@ -0,0 +1,69 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_BATCHING_INSPECTOR_H
+#define QSK_BATCHING_INSPECTOR_H
+
+#include "QskGlobal.h"
+#include <qvector.h>
+
+class QQuickWindow;
+class QQuickItem;
+
+/*
+    QskBatchingInspector walks the scene graph of a window in render
+    order and reports the geometry nodes per item and node role
+    of its skinlet.
+
+    The batch breaks are an estimation: a new batch is counted, whenever
+    the material of a geometry node is not compatible with the material
+    of the previous one or a clip node is entered. The reordering of opaque
+    nodes, that is done by the renderer of Qt/Quick, is not considered.
+
+    The scene graph is inspected from the GUI thread and must not be
+    done while being synchronized.
+ */
+class QSK_EXPORT QskBatchingInspector
+{
+  public:
+    class Entry
+    {
+      public:
+        const QQuickItem* item = nullptr;
+        quint8 nodeRole = 0xff; // QskSGNode::NoRole
+
+        // class names of the materials
+        QVector< const char* > materials;
+
+        int nodeCount = 0;
+        int vertexCount = 0;
+        int batchBreaks = 0;
+    };
+
+    class Report
+    {
+      public:
+        // in render order, consecutive nodes of the same role are merged
+        QVector< Entry > entries;
+
+        int nodeCount = 0;
+        int vertexCount = 0;
+        int batchBreaks = 0;
+
+        int materialTypeCount = 0;
+        int materialCount = 0; // materials, that can't be batched
+    };
+
+    static Report inspect( const QQuickWindow* );
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskBatchingInspector::Report& );
+
+#endif
+
+#endif
@@ -6,6 +6,9 @@
 #include "QskDirtyItemFilter.h"
 #include "QskQuickItem.h"
 
+#include <qpointer.h>
+#include <qvector.h>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
 #include <private/qquickwindow_p.h>
@@ -19,22 +22,72 @@ static inline bool qskIsUpdateBlocked( const QQuickItem* item )
             return qskItem->testUpdateFlag( QskQuickItem::DeferredUpdate );
     }
 
-#if 0
+    return false;
+}
+
+static inline bool qskIsOffscreen( const QQuickItem* item )
+{
     /*
-        Blocking items, that are outside the window would be easy,
-        but we have not yet found a performant way to send update notifications
-        when an item enters/leaves the window. TODO ...
+        The visible region of the item is the window clipped by
+        the clip rectangles of its ancestors. F.e. for the content
+        of a QskScrollArea this is the viewport.
      */
-    else if ( const auto control = qskControlCast( item ) )
+    const auto window = item->window();
+
+    const auto itemRect = item->mapRectToScene( item->boundingRect() );
+    QRectF visibleRect( 0.0, 0.0, window->width(), window->height() );
+
+    for ( auto p = item->parentItem(); p != nullptr; p = p->parentItem() )
     {
-        const QRectF itemRect( item->mapToScene( QPointF() ), item->size() );
-        const QRectF sceneRect( 0, 0, item->window()->width(), item->window()->height() );
+        if ( p->clip() )
+        {
+            visibleRect &= p->mapRectToScene( p->clipRect() );
+            if ( !visibleRect.intersects( itemRect ) )
+                return true;
+        }
+    }
 
-        return !itemRect.intersects( sceneRect );
+    return !visibleRect.intersects( itemRect );
+}
+
+static inline bool qskIsCulled( const QQuickItem* item )
+{
+    auto qskItem = qobject_cast< const QskQuickItem* >( item );
+    if ( qskItem == nullptr
+        || !qskItem->testUpdateFlag( QskQuickItem::DeferredOffscreenUpdate ) )
+    {
+        return false;
     }
-#endif
 
-    return false;
+    /*
+        Only updates of the paint node can be deferred. All other
+        updates might have an effect on the node trees of the children.
+     */
+    const auto d = QQuickItemPrivate::get( item );
+    if ( d->dirtyAttributes & ~QQuickItemPrivate::ContentUpdateMask )
+        return false;
+
+    return qskIsOffscreen( item );
+}
+
+static inline void qskInsertDirtyItem( QQuickWindow* window, QQuickItem* item )
+{
+    /*
+        Like QQuickItemPrivate::addToDirtyList, but without
+        scheduling another frame, as we are inside of one.
+     */
+    auto d = QQuickItemPrivate::get( item );
+    if ( d->prevDirtyItem )
+        return;
+
+    auto wd = QQuickWindowPrivate::get( window );
+
+    d->nextDirtyItem = wd->dirtyItemList;
+    if ( d->nextDirtyItem )
+        QQuickItemPrivate::get( d->nextDirtyItem )->prevDirtyItem = &d->nextDirtyItem;
+
+    d->prevDirtyItem = &wd->dirtyItemList;
+    wd->dirtyItemList = item;
 }
 
 static inline void qskBlockDirty( QQuickItem* item, bool on )
@@ -67,6 +120,13 @@ namespace
     };
 }
 
+class QskDirtyItemFilter::CulledItems
+{
+  public:
+    // items, that have been removed from the dirty list
+    QVector< QPointer< QQuickItem > > items;
+};
+
 QskDirtyItemFilter::QskDirtyItemFilter( QObject* parent )
     : QObject( parent )
 {
@@ -74,6 +134,7 @@ QskDirtyItemFilter::QskDirtyItemFilter( QObject* parent )
 
 QskDirtyItemFilter::~QskDirtyItemFilter()
 {
+    qDeleteAll( m_windows );
 }
 
 void QskDirtyItemFilter::addWindow( QQuickWindow* window )
@@ -81,7 +142,7 @@ void QskDirtyItemFilter::addWindow( QQuickWindow* window )
     if ( m_windows.contains( window ) )
         return;
 
-    m_windows.insert( window );
+    m_windows.insert( window, new CulledItems() );
 
     /*
         Depending on the configration the scene graph runs on
@@ -98,12 +159,13 @@ void QskDirtyItemFilter::addWindow( QQuickWindow* window )
         Qt::DirectConnection );
 
     connect( window, &QObject::destroyed,
-        this, [ this, window ] { m_windows.remove( window ); } );
+        this, [ this, window ] { delete m_windows.take( window ); } );
 }
 
 void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
 {
     filterDirtyList( window, qskIsUpdateBlocked );
+    filterOffscreenItems( window );
 
     if ( QQuickWindowPrivate::get( window )->renderer == nullptr )
     {
@@ -137,3 +199,52 @@ void QskDirtyItemFilter::filterDirtyList(
         item = nextItem;
     }
 }
+
+void QskDirtyItemFilter::filterOffscreenItems( QQuickWindow* window )
+{
+    /*
+        There are no cheap notifications for items entering/leaving
+        the visible region of the window. But as scrolling or resizing
+        always results in a new frame we can check the culled items
+        here and put them back into the dirty list, when being visible
+        again.
+     */
+    auto culledItems = m_windows.value( window );
+    if ( culledItems == nullptr )
+        return;
+
+    auto& items = culledItems->items;
+
+    int count = 0;
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        auto item = items[ i ].data();
+
+        if ( item == nullptr || item->window() != window )
+            continue;
+
+        if ( QQuickItemPrivate::get( item )->prevDirtyItem )
+            continue; // updated again and inserted by Qt
+
+        if ( qskIsCulled( item ) )
+            items[ count++ ] = item;
+        else
+            qskInsertDirtyItem( window, item );
+    }
+
+    items.resize( count );
+
+    auto d = QQuickWindowPrivate::get( window );
+    for ( auto item = d->dirtyItemList; item != nullptr; )
+    {
+        auto nextItem = QQuickItemPrivate::get( item )->nextDirtyItem;
+
+        if ( qskIsCulled( item ) )
+        {
+            QQuickItemPrivate::get( item )->removeFromDirtyList();
+            items += item;
+        }
+
+        item = nextItem;
+    }
+}
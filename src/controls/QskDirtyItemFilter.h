@@ -9,7 +9,7 @@
 #include "QskGlobal.h"
 
 #include <qobject.h>
-#include <qset.h>
+#include <qhash.h>
 
 class QQuickWindow;
 class QQuickItem;
@@ -29,8 +29,10 @@ class QskDirtyItemFilter : public QObject
 
   private:
     void beforeSynchronizing( QQuickWindow* );
+    void filterOffscreenItems( QQuickWindow* );
 
-    QSet< QObject* > m_windows;
+    class CulledItems;
+    QHash< QObject*, CulledItems* > m_windows;
 };
 
 #endif
@@ -129,15 +129,17 @@ void QskHintAnimator::setControl( QskControl* control ) noexcept
 
 void QskHintAnimator::advance( qreal progress )
 {
-    const auto oldValue = currentValue();
-
-    Inherited::advance( progress );
+    /*
+        Not copying the current value, as it would
+        be detached when interpolating in place
+     */
+    const bool isModified = interpolate( progress );
 
 #if ALIGN_VALUES
     setCurrentValue( qskAligned05( currentValue() ) );
 #endif
 
-    if ( m_control && ( currentValue() != oldValue ) )
+    if ( m_control && isModified )
     {
         if ( m_updateFlags == QskAnimationHint::UpdateAuto )
         {
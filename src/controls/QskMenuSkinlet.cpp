@@ -473,7 +473,7 @@ QSGNode* QskMenuSkinlet::updateMenuNode(
             }
             case Segment:
             {
-                newNode = updateSeriesNode( skinnable, QskMenu::Segment, oldNode );
+                newNode = updateBoxesNode( skinnable, QskMenu::Segment, oldNode );
                 break;
             }
             case Cursor:
@@ -493,7 +493,7 @@ QSGNode* QskMenuSkinlet::updateMenuNode(
             }
             case Separator:
             {
-                newNode = updateSeriesNode( skinnable, QskMenu::Separator, oldNode );
+                newNode = updateBoxesNode( skinnable, QskMenu::Separator, oldNode );
                 break;
             }
         }
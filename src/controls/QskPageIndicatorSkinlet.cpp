@@ -5,6 +5,7 @@
 
 #include "QskPageIndicatorSkinlet.h"
 #include "QskPageIndicator.h"
+#include "QskBoxHints.h"
 
 #include "QskSGNode.h"
 #include "QskFunctions.h"
@@ -80,7 +81,7 @@ QSGNode* QskPageIndicatorSkinlet::updateSubNode(
             return updateBoxNode( skinnable, node, Q::Panel );
 
         case BulletsRole:
-            return updateSeriesNode( skinnable, Q::Bullet, node );
+            return updateBoxesNode( skinnable, Q::Bullet, node );
     }
 
     return Inherited::updateSubNode( skinnable, nodeRole, node );
@@ -126,6 +127,20 @@ int QskPageIndicatorSkinlet::sampleIndexAt(
 
 QSGNode* QskPageIndicatorSkinlet::updateSampleNode( const QskSkinnable* skinnable,
     QskAspect::Subcontrol subControl, int index, QSGNode* node ) const
+{
+    if ( subControl == QskPageIndicator::Bullet )
+    {
+        QskBoxHints hints;
+        const auto rect = sampleBox( skinnable, subControl, index, hints );
+
+        return QskSkinlet::updateBoxNode( skinnable, node, rect, hints );
+    }
+
+    return nullptr;
+}
+
+QRectF QskPageIndicatorSkinlet::sampleBox( const QskSkinnable* skinnable,
+    QskAspect::Subcontrol subControl, int index, QskBoxHints& hints ) const
 {
     using Q = QskPageIndicator;
 
@@ -142,11 +157,11 @@ QSGNode* QskPageIndicatorSkinlet::updateSampleNode( const QskSkinnable* skinnabl
          */
         const auto selectedStates = Q::Selected | indicator->skinStates();
 
-        return QskSkinlet::updateInterpolatedBoxNode( skinnable, node,
-            rect, Q::Bullet, Q::Bullet | selectedStates, ratio );
+        return QskSkinlet::interpolatedBox( skinnable,
+            rect, Q::Bullet, Q::Bullet | selectedStates, ratio, hints );
     }
 
-    return nullptr;
+    return Inherited::sampleBox( skinnable, subControl, index, hints );
 }
 
 QSizeF QskPageIndicatorSkinlet::sizeHint( const QskSkinnable* skinnable,
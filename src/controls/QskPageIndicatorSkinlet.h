@@ -46,6 +46,9 @@ class QSK_EXPORT QskPageIndicatorSkinlet : public QskSkinlet
 
     QSGNode* updateSampleNode( const QskSkinnable*,
         QskAspect::Subcontrol, int index, QSGNode* ) const override;
+
+    QRectF sampleBox( const QskSkinnable*,
+        QskAspect::Subcontrol, int index, QskBoxHints& ) const override;
 };
 
 #endif
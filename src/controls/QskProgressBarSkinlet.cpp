@@ -141,10 +141,7 @@ QSGNode* QskProgressBarSkinlet::updateBarNode(
 
         const auto intv = qskBarInterval( bar );
 
-        const auto stops = qskExtractedGradientStops( gradient.stops(),
-            intv.lowerBound(), intv.upperBound() );
-
-        gradient.setStops( stops );
+        gradient = gradient.extracted( intv.lowerBound(), intv.upperBound() );
         gradient.setLinearDirection( bar->orientation() );
         if ( bar->orientation() == Qt::Vertical || bar->layoutMirroring() )
             gradient.reverse();
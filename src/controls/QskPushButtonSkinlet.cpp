@@ -11,6 +11,7 @@
 #include "QskGraphic.h"
 #include "QskSubcontrolLayoutEngine.h"
 #include "QskSGNode.h"
+#include "QskBoxClipNode.h"
 
 static inline Qt::Orientation qskOrientation( const QskPushButton* button )
 {
@@ -159,15 +160,17 @@ QSGNode* QskPushButtonSkinlet::updateSplashNode(
 
     if ( clipNode )
     {
-        auto boxNode = QskSGNode::findChildNode( clipNode, SplashRole );
+        auto parentNode = static_cast< QskBoxClipNode* >( clipNode )->contentsNode();
+
+        auto boxNode = QskSGNode::findChildNode( parentNode, SplashRole );
         boxNode = updateBoxNode( button, boxNode, splashRect, Q::Splash );
 
         if ( boxNode == nullptr )
             return nullptr;
 
         QskSGNode::setNodeRole( boxNode, SplashRole );
-        if ( boxNode->parent() != clipNode )
-            clipNode->appendChildNode( boxNode );
+        if ( boxNode->parent() != parentNode )
+            parentNode->appendChildNode( boxNode );
     }
 
     return clipNode;
@@ -10,9 +10,11 @@
 #include "QskSetup.h"
 #include "QskSkin.h"
 #include "QskDirtyItemFilter.h"
+#include "QskWindowProfiler.h"
 
 #include <qglobalstatic.h>
 #include <qquickwindow.h>
+#include <qtimer.h>
 
 #if defined( QT_DEBUG )
 
@@ -49,11 +51,17 @@ static inline void qskApplyUpdateFlags(
     d->applyUpdateFlags( flags );
 }
 
-static inline void qskFilterWindow( QQuickWindow* window )
+static inline void qskFilterWindow( QQuickWindow* window, quint8 updateFlags )
 {
     if ( window == nullptr )
         return;
 
+    if ( !( updateFlags & ( QskQuickItem::DeferredUpdate
+        | QskQuickItem::DeferredOffscreenUpdate ) ) )
+    {
+        return;
+    }
+
     static QskDirtyItemFilter itemFilter;
     itemFilter.addWindow( window );
 }
@@ -88,6 +96,12 @@ namespace
         inline void remove( QskQuickItem* item )
         {
             m_items.erase( item );
+            m_deferredItems.erase( item );
+        }
+
+        inline void removeDeferred( QskQuickItem* item )
+        {
+            m_deferredItems.erase( item );
         }
 
         void updateControlFlags()
@@ -104,13 +118,76 @@ namespace
 
             for ( auto item : m_items )
             {
+                if ( isStyleChangeDeferred( item ) )
+                {
+                    /*
+                        Invisible items - f.e. prebuilt pages - are updated,
+                        when becoming visible: see QQuickItem::ItemVisibleHasChanged
+                     */
+                    auto d = QskQuickItemPrivate::get( item );
+                    static_cast< QskQuickItemPrivate* >( d )->blockStyleChange();
+
+                    m_deferredItems.insert( item );
+                    continue;
+                }
+
                 event.setAccepted( true );
                 QCoreApplication::sendEvent( item, &event );
             }
+
+            scheduleDeferredItems();
         }
 
       private:
+        static inline bool isStyleChangeDeferred( const QskQuickItem* item )
+        {
+            return !item->isVisible()
+                && item->testUpdateFlag( QskQuickItem::DeferredPolish );
+        }
+
+        void scheduleDeferredItems()
+        {
+            if ( m_deferredItems.empty() || m_isScheduled )
+                return;
+
+            if ( qskSetup->styleChangeBatchSize() > 0 )
+            {
+                m_isScheduled = true;
+
+                QTimer::singleShot( 0, qskSetup,
+                    [ this ] { processDeferredItems(); } );
+            }
+        }
+
+        void processDeferredItems()
+        {
+            m_isScheduled = false;
+
+            for ( int i = qskSetup->styleChangeBatchSize();
+                i > 0 && !m_deferredItems.empty(); i-- )
+            {
+                /*
+                    The item is removed before sending the event as an
+                    event filter or an overloaded event() might not
+                    pass it to QskQuickItem::event()
+                 */
+                auto item = *m_deferredItems.begin();
+                m_deferredItems.erase( m_deferredItems.begin() );
+
+                auto d = QskQuickItemPrivate::get( item );
+                static_cast< QskQuickItemPrivate* >( d )->unblockStyleChange();
+
+                qskSendEventTo( item, QEvent::StyleChange );
+            }
+
+            scheduleDeferredItems();
+        }
+
         std::unordered_set< QskQuickItem* > m_items;
+
+        // items waiting for QEvent::StyleChange
+        std::unordered_set< QskQuickItem* > m_deferredItems;
+        bool m_isScheduled = false;
     };
 }
 
@@ -168,8 +245,7 @@ QskQuickItem::QskQuickItem( QskQuickItemPrivate& dd, QQuickItem* parent )
 {
     setFlag( QQuickItem::ItemHasContents, true );
 
-    if ( dd.updateFlags & QskQuickItem::DeferredUpdate )
-        qskFilterWindow( window() );
+    qskFilterWindow( window(), dd.updateFlags );
 
     qskRegistry->insert( this );
 }
@@ -436,11 +512,13 @@ bool QskQuickItem::maybeUnresized() const
     if ( d->width <= 0.0 && d->height <= 0.0 )
     {
         /*
-            Unfortunately the list of items to-be-polished is not processed
-            in top/down order and we might run into updatePolish() before
-            having a proper size. But when the parentItem() is waiting
-            for to-be-polished, we assume, that we will be resized then
-            and run into another updatePolish() then.
+            QskWindow processes the list of items to-be-polished in
+            top/down order, but other windows - or the render loops,
+            when polishing outside of an update request - do not and we
+            might run into updatePolish() before having a proper size.
+            But when the parentItem() is waiting for to-be-polished, we
+            assume, that we will be resized then and run into another
+            updatePolish() then.
          */
         if ( d->polishOnResize && qskIsPolishScheduled( parentItem() ) )
             return true;
@@ -514,7 +592,7 @@ void QskQuickItem::applyUpdateFlag( UpdateFlag flag, bool on )
         {
             if ( on )
             {
-                qskFilterWindow( window() );
+                qskFilterWindow( window(), d->updateFlags );
             }
             else
             {
@@ -524,8 +602,24 @@ void QskQuickItem::applyUpdateFlag( UpdateFlag flag, bool on )
 
             break;
         }
+        case QskQuickItem::DeferredOffscreenUpdate:
+        {
+            /*
+                When disabling, the item will be put back into
+                the dirty list in the next frame.
+             */
+            if ( on )
+                qskFilterWindow( window(), d->updateFlags );
+            else if ( d->dirtyAttributes )
+                update();
+
+            break;
+        }
         case QskQuickItem::DeferredPolish:
         {
+            if ( !on && d->blockedStyleChange )
+                qskSendEventTo( this, QEvent::StyleChange );
+
             if ( !on && d->blockedPolish )
                 polish();
 
@@ -591,7 +685,15 @@ bool QskQuickItem::event( QEvent* event )
     {
         case QEvent::StyleChange:
         {
-            d_func()->clearPreviousNodes = true;
+            Q_D( QskQuickItem );
+
+            if ( d->blockedStyleChange )
+            {
+                d->blockedStyleChange = false;
+                qskRegistry->removeDeferred( this );
+            }
+
+            d->clearPreviousNodes = true;
 
             resetImplicitSize();
             polish();
@@ -710,8 +812,7 @@ void QskQuickItem::itemChange( QQuickItem::ItemChange change,
             if ( changeData.window )
             {
                 Q_D( const QskQuickItem );
-                if ( d->updateFlags & QskQuickItem::DeferredUpdate )
-                    qskFilterWindow( changeData.window );
+                qskFilterWindow( changeData.window, d->updateFlags );
             }
 
 #if 1
@@ -791,6 +892,9 @@ void QskQuickItem::itemChange( QQuickItem::ItemChange change,
 #endif
             if ( changeData.boolValue )
             {
+                if ( d->blockedStyleChange )
+                    qskSendEventTo( this, QEvent::StyleChange );
+
                 if ( d->blockedPolish )
                     polish();
 
@@ -921,6 +1025,7 @@ void QskQuickItem::updatePolish()
         aboutToShow();
     }
 
+    QskWindowProfiler::Measurement measurement( this, QskWindowProfiler::Polish );
     updateItemPolish();
 }
 
@@ -950,6 +1055,7 @@ QSGNode* QskQuickItem::updatePaintNode( QSGNode* node, UpdatePaintNodeData* data
         d->clearPreviousNodes = false;
     }
 
+    QskWindowProfiler::Measurement measurement( this, QskWindowProfiler::UpdateNode );
     return updateItemPaintNode( node );
 }
 
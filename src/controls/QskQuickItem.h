@@ -43,6 +43,7 @@ class QSK_EXPORT QskQuickItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        DeferredOffscreenUpdate =  1 << 5,
 
         DebugForceBackground    =  1 << 7
     };
@@ -166,6 +167,9 @@ class QSK_EXPORT QskQuickItem : public QQuickItem
     void updatePolish() override final;
     virtual void updateItemPolish();
 
+    // for polishing items top/down
+    friend class QskWindowPrivate;
+
     Q_DECLARE_PRIVATE( QskQuickItem )
 };
 
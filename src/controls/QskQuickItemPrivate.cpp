@@ -18,6 +18,7 @@ QskQuickItemPrivate::QskQuickItemPrivate()
     , polishOnResize( false )
     , blockedPolish( false )
     , blockedImplicitSize( true )
+    , blockedStyleChange( false )
     , clearPreviousNodes( false )
     , initiallyPainted( false )
 {
@@ -23,6 +23,8 @@ class QskQuickItemPrivate : public QQuickItemPrivate
 
   public:
     void applyUpdateFlags( QskQuickItem::UpdateFlags );
+    void blockStyleChange() { blockedStyleChange = true; }
+    void unblockStyleChange() { blockedStyleChange = false; }
 
   protected:
     virtual void layoutConstraintChanged();
@@ -54,6 +56,7 @@ class QskQuickItemPrivate : public QQuickItemPrivate
 
     bool blockedPolish : 1;
     bool blockedImplicitSize : 1;
+    bool blockedStyleChange : 1;
     bool clearPreviousNodes : 1;
 
     bool initiallyPainted : 1;
@@ -9,6 +9,7 @@
 #include "QskScrollViewSkinlet.h"
 #include "QskBoxBorderMetrics.h"
 #include "QskSGNode.h"
+#include "QskBoxClipNode.h"
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -94,6 +95,22 @@ static inline QSizeF qskScrolledItemSize( const QskScrollView* scrollView,
     return itemSize;
 }
 
+static inline bool qskIsRectangular( const QskBoxClipNode* clipNode )
+{
+    if ( clipNode->isLayered() && !clipNode->clipRect().isEmpty() )
+    {
+        /*
+            A layered clip node masks its rounded corners and is rectangular
+            for the nodes of its layer only. Until our items are rendered
+            by the layer - see QskScrollArea::updateNode - they have to be
+            clipped by the geometry.
+         */
+        return false;
+    }
+
+    return clipNode->isRectangular();
+}
+
 namespace
 {
     class ViewportClipNode final : public QQuickDefaultClipNode
@@ -110,7 +127,7 @@ namespace
             setFlag( QSGNode::OwnsMaterial, true );
         }
 
-        void copyFrom( const QSGClipNode* other )
+        void copyFrom( const QskBoxClipNode* other )
         {
             if ( other == nullptr )
             {
@@ -134,7 +151,7 @@ namespace
                 isDirty = true;
             }
 
-            if ( other->isRectangular() )
+            if ( qskIsRectangular( other ) )
             {
                 if ( !isRectangular() )
                 {
@@ -224,6 +241,31 @@ namespace
             m_isSizeChangedEnabled = on;
         }
 
+        void setLayered( bool on )
+        {
+            /*
+                In layered mode our subtree is hidden from the window and
+                rendered by the layer of the viewport clip node instead.
+                This is the same mechanism as QQuickShaderEffectSource::hideSource.
+             */
+            if ( on == m_isLayered )
+                return;
+
+            m_isLayered = on;
+
+            auto d = QQuickItemPrivate::get( this );
+
+            if ( on )
+                d->refFromEffectItem( true );
+            else
+                d->derefFromEffectItem( true );
+        }
+
+        inline bool isLayered() const
+        {
+            return m_isLayered;
+        }
+
         QRectF focusIndicatorClipRect() const override
         {
             if( scrollArea()->hasItemFocusClipping() )
@@ -284,9 +326,10 @@ namespace
             }
         }
 
-        const QSGClipNode* viewPortClipNode() const;
+        const QskBoxClipNode* viewPortClipNode() const;
 
         bool m_isSizeChangedEnabled = true;
+        bool m_isLayered = false;
     };
 
     ClipItem::ClipItem( QskScrollArea* scrollArea )
@@ -303,6 +346,7 @@ namespace
     ClipItem::~ClipItem()
     {
         enableGeometryListener( false );
+        setLayered( false );
     }
 
     void ClipItem::updateNode( QSGNode* )
@@ -362,14 +406,14 @@ namespace
         }
     }
 
-    const QSGClipNode* ClipItem::viewPortClipNode() const
+    const QskBoxClipNode* ClipItem::viewPortClipNode() const
     {
         auto node = const_cast< QSGNode* >( qskPaintNode( scrollArea() ) );
         if ( node )
             node = QskSGNode::findChildNode( node, QskScrollViewSkinlet::ContentsRootRole );
 
         if ( node && node->type() == QSGNode::ClipNodeType )
-            return static_cast< QSGClipNode* >( node );
+            return static_cast< QskBoxClipNode* >( node );
 
         return nullptr;
     }
@@ -475,6 +519,42 @@ QskScrollArea::~QskScrollArea()
     delete m_data->clipItem;
 }
 
+void QskScrollArea::updateNode( QSGNode* node )
+{
+    Inherited::updateNode( node );
+
+    QskBoxClipNode* clipNode = nullptr;
+
+    if ( auto contentsNode = QskSGNode::findChildNode(
+        node, QskScrollViewSkinlet::ContentsRootRole ) )
+    {
+        if ( contentsNode->type() == QSGNode::ClipNodeType )
+            clipNode = static_cast< QskBoxClipNode* >( contentsNode );
+    }
+
+    const bool isLayered = clipNode && clipNode->isLayered();
+
+    /*
+        Changing the effect reference is allowed from updatePaintNode,
+        but becomes effective with the next frame only. Until the subtree
+        of the clip item has its own root node it is clipped by the
+        geometry of the viewport.
+     */
+    auto clipItem = m_data->clipItem;
+    clipItem->setLayered( isLayered );
+
+    if ( isLayered )
+    {
+        QSGNode* itemNode = nullptr;
+
+        auto d = QQuickItemPrivate::get( clipItem );
+        if ( d->rootNode() )
+            itemNode = d->itemNode();
+
+        clipNode->setLayerSource( itemNode );
+    }
+}
+
 void QskScrollArea::updateLayout()
 {
     Inherited::updateLayout();
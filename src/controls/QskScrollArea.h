@@ -41,6 +41,7 @@ class QSK_EXPORT QskScrollArea : public QskScrollView
     void itemResizableChanged( bool );
 
   protected:
+    void updateNode( QSGNode* ) override;
     void updateLayout() override;
     QSizeF layoutSizeHint( Qt::SizeHint, const QSizeF& ) const override;
 
@@ -9,6 +9,7 @@
 #include "QskAspect.h"
 #include "QskQuick.h"
 #include "QskSGNode.h"
+#include "QskBoxClipNode.h"
 #include "QskSkinStateChanger.h"
 
 #include <qsgnode.h>
@@ -139,11 +140,15 @@ QSGNode* QskScrollViewSkinlet::updateSubNode(
 QSGNode* QskScrollViewSkinlet::updateContentsRootNode(
     const QskScrollView* scrollView, QSGNode* node ) const
 {
-    auto* clipNode = updateBoxClipNode( scrollView, node, QskScrollView::Viewport );
+    auto clipNode = static_cast< QskBoxClipNode* >(
+        updateBoxClipNode( scrollView, node, QskScrollView::Viewport ) );
+
     if ( clipNode == nullptr )
         return nullptr;
 
-    auto oldContentsNode = QskSGNode::findChildNode( clipNode, ContentsRootRole );
+    auto parentNode = clipNode->contentsNode();
+
+    auto oldContentsNode = QskSGNode::findChildNode( parentNode, ContentsRootRole );
     auto contentsNode = updateContentsNode( scrollView, oldContentsNode );
 
     if ( contentsNode )
@@ -157,13 +162,13 @@ QSGNode* QskScrollViewSkinlet::updateContentsRootNode(
          */
         QskSGNode::setNodeRole( contentsNode, ContentsRootRole );
 
-        if ( contentsNode->parent() != clipNode )
-            clipNode->appendChildNode( contentsNode );
+        if ( contentsNode->parent() != parentNode )
+            parentNode->appendChildNode( contentsNode );
     }
 
     if ( oldContentsNode && oldContentsNode != contentsNode )
     {
-        clipNode->removeChildNode( oldContentsNode );
+        parentNode->removeChildNode( oldContentsNode );
 
         if ( oldContentsNode->flags() & QSGNode::OwnedByParent )
             delete oldContentsNode;
@@ -185,6 +190,7 @@ QSGNode* QskScrollViewSkinlet::contentsNode( const QskScrollView* scrollView )
         node = QskSGNode::findChildNode( node, ContentsRootRole );
         if ( node )
         {
+            node = static_cast< QskBoxClipNode* >( node )->contentsNode();
             node = node->firstChild();
             if ( node )
                 return node->firstChild();
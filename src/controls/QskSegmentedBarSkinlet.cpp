@@ -11,6 +11,7 @@
 #include "QskColorFilter.h"
 #include "QskFunctions.h"
 #include "QskSGNode.h"
+#include "QskBoxClipNode.h"
 #include "QskSkin.h"
 #include "QskSkinStateChanger.h"
 #include "QskSubcontrolLayoutEngine.h"
@@ -305,10 +306,10 @@ QSGNode* QskSegmentedBarSkinlet::updateSubNode(
             return updateBoxNode( skinnable, node, Q::Panel );
 
         case SegmentRole:
-            return updateSeriesNode( skinnable, Q::Segment, node );
+            return updateBoxesNode( skinnable, Q::Segment, node );
 
         case SeparatorRole:
-            return updateSeriesNode( skinnable, Q::Separator, node );
+            return updateBoxesNode( skinnable, Q::Separator, node );
 
         case TextRole:
             return updateSeriesNode( skinnable, Q::Text, node );
@@ -545,6 +546,25 @@ QSGNode* QskSegmentedBarSkinlet::updateSampleNode( const QskSkinnable* skinnable
     return Inherited::updateSampleNode( skinnable, subControl, index, node );
 }
 
+QRectF QskSegmentedBarSkinlet::sampleBox( const QskSkinnable* skinnable,
+    QskAspect::Subcontrol subControl, int index, QskBoxHints& hints ) const
+{
+    using Q = QskSegmentedBar;
+
+    if ( subControl == Q::Segment )
+    {
+        auto bar = static_cast< const QskSegmentedBar* >( skinnable );
+
+        const auto rect = sampleRect( bar, bar->contentsRect(), subControl, index );
+        if ( !rect.isEmpty() )
+            hints = effectiveBoxHints( subControl, bar, index ).toAbsolute( rect.size() );
+
+        return rect;
+    }
+
+    return Inherited::sampleBox( skinnable, subControl, index, hints );
+}
+
 QSGNode* QskSegmentedBarSkinlet::updateSplashNode(
     const QskSegmentedBar* bar, QSGNode* node ) const
 {
@@ -559,9 +579,11 @@ QSGNode* QskSegmentedBarSkinlet::updateSplashNode(
 
     if ( clipNode )
     {
-        auto boxNode = updateBoxNode( bar, clipNode->firstChild(), splashRect, Q::Splash );
+        auto parentNode = static_cast< QskBoxClipNode* >( clipNode )->contentsNode();
+
+        auto boxNode = updateBoxNode( bar, parentNode->firstChild(), splashRect, Q::Splash );
         if ( boxNode->parent() == nullptr )
-            clipNode->appendChildNode( boxNode );
+            parentNode->appendChildNode( boxNode );
     }
 
     return clipNode;
@@ -55,6 +55,9 @@ class QSK_EXPORT QskSegmentedBarSkinlet : public QskSkinlet
     QSGNode* updateSampleNode( const QskSkinnable*,
         QskAspect::Subcontrol, int index, QSGNode* ) const override;
 
+    QRectF sampleBox( const QskSkinnable*,
+        QskAspect::Subcontrol, int index, QskBoxHints& ) const override;
+
   private:
     QSizeF segmentSizeHint(const QskSegmentedBar*, Qt::SizeHint ) const;
 
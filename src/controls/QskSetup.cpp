@@ -40,9 +40,18 @@ static inline const QskQuickItem::UpdateFlags qskEnvironmentUpdateFlags()
     if ( qskHasEnvironment( "QSK_FORCE_BACKGROUND" ) )
         flags |= QskQuickItem::DebugForceBackground;
 
+    if ( qskHasEnvironment( "QSK_DEFERRED_OFFSCREEN_UPDATE" ) )
+        flags |= QskQuickItem::DeferredOffscreenUpdate;
+
     return flags;
 }
 
+static inline int qskDefaultAnimationFrameRate()
+{
+    // f.e a low power mode for battery driven devices
+    return qMax( qEnvironmentVariableIntValue( "QSK_ANIMATION_FPS" ), 0 );
+}
+
 static inline QskQuickItem::UpdateFlags qskDefaultUpdateFlags()
 {
     static QskQuickItem::UpdateFlags flags;
@@ -86,6 +95,8 @@ class QskSetup::PrivateData
 
     QskGraphicProviderMap graphicProviders;
     QskQuickItem::UpdateFlags itemUpdateFlags;
+    int styleChangeBatchSize = 0;
+    int animationFrameRate = qskDefaultAnimationFrameRate();
 };
 
 QskSetup::QskSetup()
@@ -152,6 +163,31 @@ bool QskSetup::testItemUpdateFlag( QskQuickItem::UpdateFlag flag )
     return m_data->itemUpdateFlags.testFlag( flag );
 }
 
+void QskSetup::setStyleChangeBatchSize( int size )
+{
+    m_data->styleChangeBatchSize = qMax( size, 0 );
+}
+
+int QskSetup::styleChangeBatchSize() const
+{
+    return m_data->styleChangeBatchSize;
+}
+
+void QskSetup::setAnimationFrameRate( int fps )
+{
+    m_data->animationFrameRate = qMax( fps, 0 );
+}
+
+void QskSetup::resetAnimationFrameRate()
+{
+    m_data->animationFrameRate = qskDefaultAnimationFrameRate();
+}
+
+int QskSetup::animationFrameRate() const
+{
+    return m_data->animationFrameRate;
+}
+
 QskSkin* QskSetup::setSkin( const QString& skinName )
 {
     if ( m_data->skin && ( skinName == m_data->skinName ) )
@@ -38,6 +38,24 @@ class QSK_EXPORT QskSetup : public QObject
     void resetItemUpdateFlag( QskQuickItem::UpdateFlag );
     bool testItemUpdateFlag( QskQuickItem::UpdateFlag );
 
+    /*
+        On skin changes items, that are invisible and have the DeferredPolish
+        flag, receive QEvent::StyleChange when becoming visible. With a batch size > 0
+        the deferred events are also sent in idle time - batchSize items at a time.
+     */
+    void setStyleChangeBatchSize( int );
+    int styleChangeBatchSize() const;
+
+    /*
+        Limits how often animators are advanced and windows
+        are updated because of running animations. 0 means unlimited,
+        what is the default unless QSK_ANIMATION_FPS is set.
+        The progress of the animations is not affected.
+     */
+    void setAnimationFrameRate( int fps );
+    void resetAnimationFrameRate();
+    int animationFrameRate() const;
+
     QskSkin* setSkin( const QString& );
     QString skinName() const;
 
@@ -13,6 +13,8 @@
 #include "QskSkinHintTable.h"
 #include "QskStandardSymbol.h"
 #include "QskPlatform.h"
+#include "QskQuick.h"
+#include "QskWindow.h"
 
 #include "QskMargins.h"
 
@@ -98,6 +100,23 @@
 #include "QskStatusIndicator.h"
 #include "QskStatusIndicatorSkinlet.h"
 
+static void qskUpdateItems( const QskSkin* skin )
+{
+    /*
+        Settings, that are evaluated by the skinlets when updating
+        the nodes: f.e. distance field boxes or layered clipping.
+     */
+    const auto windows = QGuiApplication::allWindows();
+    for ( auto window : windows )
+    {
+        if ( auto quickWindow = qobject_cast< QQuickWindow* >( window ) )
+        {
+            if ( qskEffectiveSkin( quickWindow ) == skin )
+                qskItemUpdateRecursive( quickWindow->contentItem() );
+        }
+    }
+}
+
 static inline QskSkinlet* qskNewSkinlet( const QMetaObject* metaObject, QskSkin* skin )
 {
     const QByteArray signature = metaObject->className() + QByteArrayLiteral( "(QskSkin*)" );
@@ -146,6 +165,10 @@ class QskSkin::PrivateData
     std::unordered_map< int, QskColorFilter > graphicFilters;
 
     QskGraphicProviderMap graphicProviders;
+
+    bool distanceFieldBoxes = false;
+    bool layeredClipping = false;
+    bool flatColorBoxes = false;
 };
 
 QskSkin::QskSkin( QObject* parent )
@@ -339,6 +362,48 @@ bool QskSkin::hasGraphicProvider() const
     return m_data->graphicProviders.size() > 0;
 }
 
+void QskSkin::setDistanceFieldBoxes( bool on )
+{
+    if ( on != m_data->distanceFieldBoxes )
+    {
+        m_data->distanceFieldBoxes = on;
+        qskUpdateItems( this );
+    }
+}
+
+bool QskSkin::hasDistanceFieldBoxes() const
+{
+    return m_data->distanceFieldBoxes;
+}
+
+void QskSkin::setLayeredClipping( bool on )
+{
+    if ( on != m_data->layeredClipping )
+    {
+        m_data->layeredClipping = on;
+        qskUpdateItems( this );
+    }
+}
+
+bool QskSkin::hasLayeredClipping() const
+{
+    return m_data->layeredClipping;
+}
+
+void QskSkin::setFlatColorBoxes( bool on )
+{
+    if ( on != m_data->flatColorBoxes )
+    {
+        m_data->flatColorBoxes = on;
+        qskUpdateItems( this );
+    }
+}
+
+bool QskSkin::hasFlatColorBoxes() const
+{
+    return m_data->flatColorBoxes;
+}
+
 QString QskSkin::dialogButtonText( int action ) const
 {
     const auto theme = qskPlatformTheme();
@@ -84,6 +84,30 @@ class QSK_EXPORT QskSkin : public QObject
     QskGraphicProvider* graphicProvider( const QString& providerId ) const;
     bool hasGraphicProvider() const;
 
+    /*
+        Render boxes with a monochrome fill and a uniform border
+        using a signed distance function instead of tessellating
+        the rounded corners. See QskBoxRectangleNode.
+     */
+    void setDistanceFieldBoxes( bool );
+    bool hasDistanceFieldBoxes() const;
+
+    /*
+        Render the nodes below rounded clips into an offscreen texture,
+        that is composited with a rounded mask, instead of clipping
+        with the stencil buffer. See QskBoxClipNode::setLayered.
+     */
+    void setLayeredClipping( bool );
+    bool hasLayeredClipping() const;
+
+    /*
+        Render boxes, that can be done with one color, with a flat
+        color material instead of colored vertices. See
+        QskBoxRectangleNode::ColorPolicy.
+     */
+    void setFlatColorBoxes( bool );
+    bool hasFlatColorBoxes() const;
+
     virtual const int* dialogButtonLayout( Qt::Orientation ) const;
     virtual QString dialogButtonText( int button ) const;
 
@@ -17,6 +17,7 @@
 #include <qobject.h>
 #include <qvector.h>
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -88,10 +89,15 @@ namespace
 
         static inline bool compare( const UpdateInfo& i1, const UpdateInfo& i2 )
         {
-            return i1.control.data() < i2.control.data();
+            return i1.control < i2.control;
         }
 
-        QPointer< QskControl > control;
+        /*
+            A raw pointer, so that the ordering of the update infos
+            remains valid: destroyed controls are removed, see
+            WindowAnimator::removeControl()
+         */
+        QskControl* control;
         int updateModes;
     };
 
@@ -131,7 +137,13 @@ namespace
 
         void addItemAspects( QQuickItem*,
             const QskAnimationHint&, const QSet< QskAspect >&,
-            const QskSkin*, const QskSkin* );
+            const QskSkin*, const QskSkin*, const QRectF& clipRect );
+
+        bool isAnimated( const QQuickItem* ) const;
+        int animatorCount() const;
+
+        void removeControl( const QObject* );
+        void disconnectControls( QObject* receiver );
 
         void update();
 
@@ -163,6 +175,9 @@ namespace
         ~ApplicationAnimator() override;
 
         WindowAnimator* windowAnimator( const QQuickWindow* );
+        int animatorCount() const;
+
+        quint32 transitionId() const;
 
         void add( WindowAnimator* );
 
@@ -174,6 +189,7 @@ namespace
         // using functor slots ?
         void notify( QQuickWindow* );
         void cleanup( QQuickWindow* );
+        void removeControl( QObject* );
 
       private:
         /*
@@ -185,6 +201,8 @@ namespace
          */
         std::vector< WindowAnimator* > m_windowAnimators;
         QMetaObject::Connection m_connections[2];
+
+        quint32 m_transitionId = 0;
     };
 }
 
@@ -287,14 +305,24 @@ void WindowAnimator::addGraphicFilterAnimators( const QskAnimationHint& animator
 
 void WindowAnimator::addItemAspects( QQuickItem* item,
     const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
-    const QskSkin* skin1, const QskSkin* skin2  )
-{
+    const QskSkin* skin1, const QskSkin* skin2, const QRectF& clipRect )
+{
+    /*
+        Controls, that are hidden - f.e pages of a stack box or closed
+        popups - or are outside of the viewport are not animated. As they
+        are not part of the update infos they get the hints of the
+        new skin directly: see isAnimated().
+     */
     if ( !item->isVisible() )
         return;
 
+    const auto rect = item->mapRectToScene(
+        QRectF( 0.0, 0.0, item->width(), item->height() ) );
+
     if ( auto control = qskControlCast( item ) )
     {
-        if ( control->isInitiallyPainted() && ( control->effectiveSkin() == skin2 ) )
+        if ( control->isInitiallyPainted() && ( control->effectiveSkin() == skin2 )
+            && rect.intersects( clipRect ) )
         {
             addHints( control, animatorHint, candidates, skin1, skin2 );
 #if 1
@@ -308,26 +336,74 @@ void WindowAnimator::addItemAspects( QQuickItem* item,
         }
     }
 
+    auto childClipRect = clipRect;
+
+    if ( item->clip() )
+    {
+        // f.e the viewport of a scroll area
+        childClipRect &= rect;
+
+        if ( childClipRect.isEmpty() )
+            return;
+    }
+
     const auto children = item->childItems();
     for ( auto child : children )
-        addItemAspects( child, animatorHint, candidates, skin1, skin2 );
+    {
+        addItemAspects( child, animatorHint,
+            candidates, skin1, skin2, childClipRect );
+    }
+}
+
+bool WindowAnimator::isAnimated( const QQuickItem* item ) const
+{
+    auto it = std::lower_bound( m_updateInfos.begin(), m_updateInfos.end(), item,
+        []( const UpdateInfo& info, const QQuickItem* item )
+        { return info.control < item; } );
+
+    return ( it != m_updateInfos.end() ) && ( it->control == item );
+}
+
+void WindowAnimator::removeControl( const QObject* object )
+{
+    /*
+        Called from QObject::destroyed, when the control has already
+        been destructed down to QObject. So we compare the QObject addresses.
+     */
+    auto it = std::find_if( m_updateInfos.begin(), m_updateInfos.end(),
+        [object]( const UpdateInfo& info )
+        { return static_cast< const QObject* >( info.control ) == object; } );
+
+    if ( it != m_updateInfos.end() )
+        m_updateInfos.erase( it );
+}
+
+void WindowAnimator::disconnectControls( QObject* receiver )
+{
+    for ( const auto& info : m_updateInfos )
+        info.control->disconnect( receiver );
+}
+
+int WindowAnimator::animatorCount() const
+{
+    return static_cast< int >(
+        m_animatorMap.size() + m_graphicFilterAnimatorMap.size() );
 }
 
 void WindowAnimator::update()
 {
     for ( auto& info : m_updateInfos )
     {
-        if ( auto control = info.control )
-        {
-            if ( info.updateModes & UpdateInfo::Polish )
-            {
-                control->resetImplicitSize();
-                control->polish();
-            }
+        auto control = info.control;
 
-            if ( info.updateModes & UpdateInfo::Update )
-                control->update();
+        if ( info.updateModes & UpdateInfo::Polish )
+        {
+            control->resetImplicitSize();
+            control->polish();
         }
+
+        if ( info.updateModes & UpdateInfo::Update )
+            control->update();
     }
 }
 
@@ -451,9 +527,16 @@ inline void WindowAnimator::storeUpdateInfo( const QskControl* control, QskAspec
         m_updateInfos.begin(), m_updateInfos.end(), info, UpdateInfo::compare );
 
     if ( ( it != m_updateInfos.end() ) && ( it->control == info.control ) )
+    {
         it->updateModes |= info.updateModes;
+    }
     else
+    {
         m_updateInfos.insert( it, info );
+
+        QObject::connect( control, SIGNAL(destroyed(QObject*)),
+            qskApplicationAnimator, SLOT(removeControl(QObject*)) );
+    }
 }
 
 ApplicationAnimator::~ApplicationAnimator()
@@ -475,6 +558,21 @@ inline WindowAnimator* ApplicationAnimator::windowAnimator( const QQuickWindow*
     return nullptr;
 }
 
+int ApplicationAnimator::animatorCount() const
+{
+    int count = 0;
+
+    for ( const auto animator : m_windowAnimators )
+        count += animator->animatorCount();
+
+    return count;
+}
+
+inline quint32 ApplicationAnimator::transitionId() const
+{
+    return m_transitionId;
+}
+
 void ApplicationAnimator::add( WindowAnimator* animator )
 {
     m_windowAnimators.push_back( animator );
@@ -490,10 +588,15 @@ void ApplicationAnimator::start()
 
     for ( auto& animator : m_windowAnimators )
         animator->start();
+
+    m_transitionId++;
 }
 
 void ApplicationAnimator::reset()
 {
+    for ( auto animator : m_windowAnimators )
+        animator->disconnectControls( this );
+
     qDeleteAll( m_windowAnimators );
     m_windowAnimators.clear();
 
@@ -531,6 +634,8 @@ void ApplicationAnimator::cleanup( QQuickWindow* window )
                 // The notification might be for other animators
 
                 m_windowAnimators.erase( it );
+
+                animator->disconnectControls( this );
                 delete animator;
             }
 
@@ -545,6 +650,12 @@ void ApplicationAnimator::cleanup( QQuickWindow* window )
         reset();
 }
 
+void ApplicationAnimator::removeControl( QObject* object )
+{
+    for ( auto animator : m_windowAnimators )
+        animator->removeControl( object );
+}
+
 class QskSkinTransition::PrivateData
 {
   public:
@@ -655,8 +766,10 @@ void QskSkinTransition::process()
                    over the the item trees.
                  */
 
+                const QRectF clipRect( 0.0, 0.0, w->width(), w->height() );
+
                 animator->addItemAspects( w->contentItem(),
-                    m_data->animationHint, candidates, skin1, skin2 );
+                    m_data->animationHint, candidates, skin1, skin2, clipRect );
 
                 qskApplicationAnimator->add( animator );
             }
@@ -689,6 +802,33 @@ QVariant QskSkinTransition::animatedHint(
     return QVariant();
 }
 
+bool QskSkinTransition::isAnimated( const QQuickItem* item )
+{
+    if ( item && qskApplicationAnimator.exists() )
+    {
+        if ( const auto animator = qskApplicationAnimator->windowAnimator( item->window() ) )
+            return animator->isAnimated( item );
+    }
+
+    return false;
+}
+
+quint32 QskSkinTransition::transitionId()
+{
+    if ( qskApplicationAnimator.exists() )
+        return qskApplicationAnimator->transitionId();
+
+    return 0;
+}
+
+int QskSkinTransition::animatorCount()
+{
+    if ( qskApplicationAnimator.exists() )
+        return qskApplicationAnimator->animatorCount();
+
+    return 0;
+}
+
 QVariant QskSkinTransition::animatedGraphicFilter(
     const QQuickWindow* window, int graphicRole )
 {
@@ -7,6 +7,7 @@
 class QskSkin;
 class QskAnimationHint;
 class QQuickWindow;
+class QQuickItem;
 class QVariant;
 
 class QSK_EXPORT QskSkinTransition
@@ -38,6 +39,22 @@ class QSK_EXPORT QskSkinTransition
     void process();
 
     static bool isRunning();
+
+    /*
+        Only controls being visible in the viewport are animated, all
+        others get the hints of the target skin immediately
+     */
+    static bool isAnimated( const QQuickItem* );
+
+    /*
+        Changes with each started transition and can be used
+        to cache the result of isAnimated()
+     */
+    static quint32 transitionId();
+
+    // number of animators of the running transition
+    static int animatorCount();
+
     static QVariant animatedHint( const QQuickWindow*, QskAspect );
     static QVariant animatedGraphicFilter( const QQuickWindow*, int graphicRole );
 
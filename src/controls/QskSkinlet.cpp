@@ -12,6 +12,7 @@
 #include "QskBoxBorderMetrics.h"
 #include "QskBoxNode.h"
 #include "QskBoxClipNode.h"
+#include "QskBoxesNode.h"
 #include "QskBoxRectangleNode.h"
 #include "QskBoxShapeMetrics.h"
 #include "QskBoxHints.h"
@@ -31,9 +32,12 @@
 #include "QskSkinStateChanger.h"
 #include "QskTextureRenderer.h"
 #include "QskSetup.h"
+#include "QskSkin.h"
+#include "QskWindow.h"
 
 #include <qquickwindow.h>
 #include <qsgsimplerectnode.h>
+#include <qvarlengtharray.h>
 
 static inline QRectF qskSceneAlignedRect( const QQuickItem* item, const QRectF& rect )
 {
@@ -191,8 +195,50 @@ static inline QskTextColors qskTextColors(
     return c;
 }
 
+static inline bool qskHasDistanceFieldBoxes( const QskSkinnable* skinnable )
+{
+    if ( auto item = skinnable->owningItem() )
+    {
+        if ( auto window = qobject_cast< const QskWindow* >( item->window() ) )
+            return window->hasDistanceFieldBoxes();
+    }
+
+    if ( auto skin = skinnable->effectiveSkin() )
+        return skin->hasDistanceFieldBoxes();
+
+    return false;
+}
+
+static inline bool qskHasLayeredClipping( const QskSkinnable* skinnable )
+{
+    if ( auto item = skinnable->owningItem() )
+    {
+        if ( auto window = qobject_cast< const QskWindow* >( item->window() ) )
+            return window->hasLayeredClipping();
+    }
+
+    if ( auto skin = skinnable->effectiveSkin() )
+        return skin->hasLayeredClipping();
+
+    return false;
+}
+
+static inline bool qskHasFlatColorBoxes( const QskSkinnable* skinnable )
+{
+    if ( auto item = skinnable->owningItem() )
+    {
+        if ( auto window = qobject_cast< const QskWindow* >( item->window() ) )
+            return window->hasFlatColorBoxes();
+    }
+
+    if ( auto skin = skinnable->effectiveSkin() )
+        return skin->hasFlatColorBoxes();
+
+    return false;
+}
+
 static inline QSGNode* qskUpdateBoxNode(
-    const QskSkinnable*, QSGNode* node, const QRectF& rect,
+    const QskSkinnable* skinnable, QSGNode* node, const QRectF& rect,
     const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
     const QskBoxBorderColors& borderColors, const QskGradient& gradient,
     const QskShadowMetrics& shadowMetrics, const QColor& shadowColor )
@@ -210,6 +256,9 @@ static inline QSGNode* qskUpdateBoxNode(
         const auto absoluteShadowMetrics = shadowMetrics.toAbsolute( size );
 
         auto boxNode = QskSGNode::ensureNode< QskBoxNode >( node );
+        boxNode->setDistanceFieldEnabled( qskHasDistanceFieldBoxes( skinnable ) );
+        boxNode->setColorPolicy( qskHasFlatColorBoxes( skinnable )
+            ? QskBoxRectangleNode::FlatColors : QskBoxRectangleNode::VertexColors );
         boxNode->updateNode( rect, absoluteShape, absoluteMetrics,
             borderColors, gradient, absoluteShadowMetrics, shadowColor );
 
@@ -498,6 +547,15 @@ QSGNode* QskSkinlet::updateInterpolatedBoxNode(
     QskAspect aspect1, QskAspect aspect2, qreal ratio )
 {
     QskBoxHints boxHints;
+    const auto r = interpolatedBox( skinnable, rect, aspect1, aspect2, ratio, boxHints );
+
+    return QskSkinlet::updateBoxNode( skinnable, node, r, boxHints );
+}
+
+QRectF QskSkinlet::interpolatedBox( const QskSkinnable* skinnable,
+    const QRectF& rect, QskAspect aspect1, QskAspect aspect2,
+    qreal ratio, QskBoxHints& boxHints )
+{
     QRectF r;
 
     ratio = qBound( 0.0, ratio, 1.0 );
@@ -529,7 +587,7 @@ QSGNode* QskSkinlet::updateInterpolatedBoxNode(
         boxHints = boxHints1.interpolated( boxHints2, ratio );
     }
 
-    return QskSkinlet::updateBoxNode( skinnable, node, r, boxHints );
+    return r;
 }
 
 QSGNode* QskSkinlet::updateArcNode( const QskSkinnable* skinnable,
@@ -650,6 +708,9 @@ QSGNode* QskSkinlet::updateBoxClipNode( const QskSkinnable* skinnable,
 {
     auto clipNode = QskSGNode::ensureNode< QskBoxClipNode >( node );
 
+    if ( auto item = skinnable->owningItem() )
+        clipNode->setLayered( item->window(), qskHasLayeredClipping( skinnable ) );
+
     const auto margins = skinnable->marginHint( subControl );
 
     const auto clipRect = rect.marginsRemoved( margins );
@@ -780,6 +841,33 @@ int QskSkinlet::sampleIndexAt( const QskSkinnable* skinnable,
     return -1;
 }
 
+namespace
+{
+    class IndexChanger
+    {
+      public:
+        inline IndexChanger( const QskSkinlet* skinlet, int index )
+            : m_skinlet( const_cast< QskSkinlet* >( skinlet ) )
+        {
+            m_skinlet->setAnimatorIndex( index );
+        }
+
+        inline ~IndexChanger()
+        {
+            m_skinlet->resetAnimatorIndex();
+        }
+      private:
+        QskSkinlet* m_skinlet;
+    };
+
+    class SampleBox
+    {
+      public:
+        QRectF rect;
+        QskBoxHints hints;
+    };
+}
+
 QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
     QskAspect::Subcontrol subControl, QSGNode* rootNode ) const
 {
@@ -798,23 +886,6 @@ QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
             QskSkinStateChanger stateChanger( skinnable );
             stateChanger.setStates( newStates );
 
-            class IndexChanger
-            {
-              public:
-                inline IndexChanger( const QskSkinlet* skinlet, int index )
-                    : m_skinlet( const_cast< QskSkinlet* >( skinlet ) )
-                {
-                    m_skinlet->setAnimatorIndex( index );
-                }
-
-                inline ~IndexChanger()
-                {
-                    m_skinlet->resetAnimatorIndex();
-                }
-              private:
-                QskSkinlet* m_skinlet;
-            };
-
             IndexChanger indexChanger( this, i );
 
             newNode = updateSampleNode( skinnable, subControl, i, node );
@@ -846,6 +917,114 @@ QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
     return rootNode;
 }
 
+static inline bool qskIsBoxesNode( const QSGNode* node )
+{
+    // the root node of updateSeriesNode() is a plain QSGNode
+    return node && node->type() == QSGNode::GeometryNodeType;
+}
+
+QSGNode* QskSkinlet::updateBoxesNode( const QskSkinnable* skinnable,
+    QskAspect::Subcontrol subControl, QSGNode* node ) const
+{
+    if ( qskHasDistanceFieldBoxes( skinnable ) )
+    {
+        std::unique_ptr< QskBoxesNode > newNode;
+
+        auto boxesNode = static_cast< QskBoxesNode* >( node );
+        if ( !qskIsBoxesNode( node ) )
+        {
+            newNode.reset( new QskBoxesNode() );
+            boxesNode = newNode.get();
+        }
+
+        const auto count = sampleCount( skinnable, subControl );
+
+        /*
+            Collecting the visible boxes first, so that the
+            node is resized only once.
+         */
+        QVarLengthArray< SampleBox, 16 > boxes;
+
+        bool ok = true;
+
+        for ( int i = 0; ok && ( i < count ); i++ )
+        {
+            SampleBox box;
+
+            {
+                const auto newStates = sampleStates( skinnable, subControl, i );
+
+                QskSkinStateChanger stateChanger( skinnable );
+                stateChanger.setStates( newStates );
+
+                IndexChanger indexChanger( this, i );
+
+                box.rect = sampleBox( skinnable, subControl, i, box.hints );
+            }
+
+            const auto& hints = box.hints;
+
+            if ( box.rect.isEmpty() || !qskIsBoxVisible(
+                hints.borderMetrics, hints.borderColors, hints.gradient ) )
+            {
+                continue;
+            }
+
+            if ( !hints.shadowMetrics.isNull()
+                && hints.shadowColor.isValid() && hints.shadowColor.alpha() != 0 )
+            {
+                ok = false;
+            }
+            else
+            {
+                boxes.append( box );
+            }
+        }
+
+        if ( ok )
+        {
+            if ( boxes.isEmpty() )
+                return nullptr;
+
+            boxesNode->setBoxCount( static_cast< int >( boxes.size() ) );
+
+            for ( int i = 0; ok && ( i < boxes.size() ); i++ )
+            {
+                const auto& box = boxes[i];
+                const auto& hints = box.hints;
+
+                ok = boxesNode->setBox( i, box.rect, hints.shape,
+                    hints.borderMetrics, hints.borderColors, hints.gradient );
+            }
+        }
+
+        if ( ok )
+        {
+            newNode.release();
+            return boxesNode;
+        }
+    }
+
+    return updateSeriesNode( skinnable, subControl,
+        qskIsBoxesNode( node ) ? nullptr : node );
+}
+
+QRectF QskSkinlet::sampleBox( const QskSkinnable* skinnable,
+    QskAspect::Subcontrol subControl, int index, QskBoxHints& hints ) const
+{
+    QRectF rect;
+
+    if ( auto control = skinnable->controlCast() )
+        rect = sampleRect( skinnable, control->contentsRect(), subControl, index );
+
+    rect = rect.marginsRemoved( skinnable->marginHint( subControl ) );
+
+    if ( !rect.isEmpty() )
+        hints = skinnable->boxHints( subControl ).toAbsolute( rect.size() );
+
+    return rect;
+}
+
 QSGNode* QskSkinlet::updateSampleNode( const QskSkinnable*,
     QskAspect::Subcontrol, int index, QSGNode* ) const
 {
@@ -94,6 +94,13 @@ class QSK_EXPORT QskSkinlet
         const QskSkinnable*, QSGNode*, const QRectF&,
         QskAspect aspect1, QskAspect aspect2, qreal ratio );
 
+    /*
+        The rectangle without margins and the absolute box hints
+        in between aspect1 and aspect2
+     */
+    static QRectF interpolatedBox( const QskSkinnable*, const QRectF&,
+        QskAspect aspect1, QskAspect aspect2, qreal ratio, QskBoxHints& );
+
     static QSGNode* updateArcNode( const QskSkinnable*, QSGNode*,
         const QRectF&, QskAspect::Subcontrol );
 
@@ -134,6 +141,12 @@ class QSK_EXPORT QskSkinlet
         const QskGraphic&, const QskColorFilter&, const QRectF&,
         Qt::Orientations mirrored = Qt::Orientations() );
 
+    /*
+        Returns a QskBoxClipNode, that might be layered - see
+        QskSkin::setLayeredClipping(). The clipped nodes have to be
+        inserted to QskBoxClipNode::contentsNode() and never to the
+        clip node itself.
+     */
     static QSGNode* updateBoxClipNode( const QskSkinnable*, QSGNode*,
         const QRectF&, QskAspect::Subcontrol );
 
@@ -179,6 +192,24 @@ class QSK_EXPORT QskSkinlet
     virtual QSGNode* updateSampleNode( const QskSkinnable*,
         QskAspect::Subcontrol, int index, QSGNode* ) const;
 
+    /*
+        Samples, that are simple boxes, can be rendered into a single
+        node ( QskBoxesNode ), instead of having a node for each sample.
+        updateBoxesNode() falls back to updateSeriesNode(), when distance
+        field boxes are disabled or a box has a shadow or can't be
+        rendered by the distance field material.
+     */
+    QSGNode* updateBoxesNode( const QskSkinnable*,
+        QskAspect::Subcontrol, QSGNode* ) const;
+
+    /*
+        The rectangle without margins and the absolute box hints of a sample
+        for updateBoxesNode(). The states of the sample have already been
+        set, when being called.
+     */
+    virtual QRectF sampleBox( const QskSkinnable*,
+        QskAspect::Subcontrol, int index, QskBoxHints& ) const;
+
     void replaceChildNode( quint8 nodeRole, QSGNode* parentNode,
         QSGNode* oldNode, QSGNode* newNode ) const;
 
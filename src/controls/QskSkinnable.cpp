@@ -18,6 +18,7 @@
 #include "QskSkinTransition.h"
 #include "QskSkinlet.h"
 #include "QskWindow.h"
+#include "QskWindowProfiler.h"
 
 #include "QskBoxShapeMetrics.h"
 #include "QskBoxBorderMetrics.h"
@@ -245,6 +246,10 @@ class QskSkinnable::PrivateData
 
     QskAspect::States skinStates;
     bool hasLocalSkinlet = false;
+
+    // caching QskSkinTransition::isAnimated: see interpolatedHint()
+    mutable quint32 transitionId = 0;
+    mutable bool isTransitionAnimated = false;
 };
 
 QskSkinnable::QskSkinnable()
@@ -615,10 +620,16 @@ QColor QskSkinnable::shadowColorHint( QskAspect aspect, QskSkinHintStatus* statu
 
 QskBoxHints QskSkinnable::boxHints( QskAspect aspect ) const
 {
-    return QskBoxHints(
-        boxShapeHint( aspect ), boxBorderMetricsHint( aspect ),
-        boxBorderColorsHint( aspect ), gradientHint( aspect ),
-        shadowMetricsHint( aspect ), shadowColorHint( aspect ) );
+    QskBoxHints hints;
+
+    hints.shape = boxShapeHint( aspect );
+    hints.borderMetrics = boxBorderMetricsHint( aspect );
+    hints.borderColors = boxBorderColorsHint( aspect );
+    hints.gradient = gradientHint( aspect );
+    hints.shadowMetrics = shadowMetricsHint( aspect );
+    hints.shadowColor = shadowColorHint( aspect );
+
+    return hints;
 }
 
 bool QskSkinnable::setArcMetricsHint(
@@ -910,6 +921,9 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 QVariant QskSkinnable::effectiveSkinHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
+    QskWindowProfiler::Measurement measurement(
+        this, QskWindowProfiler::ResolveHint );
+
     aspect.setSubcontrol( effectiveSubcontrol( aspect.subControl() ) );
 
     if ( !( aspect.isAnimator() || aspect.hasStates() ) )
@@ -1005,10 +1019,27 @@ QVariant QskSkinnable::interpolatedHint(
     if ( !QskSkinTransition::isRunning() || m_data->hintTable.hasHint( aspect ) )
         return QVariant();
 
+    const auto transitionId = QskSkinTransition::transitionId();
+    if ( m_data->transitionId == transitionId && !m_data->isTransitionAnimated )
+        return QVariant();
+
     const auto item = owningItem();
     if ( item == nullptr )
         return QVariant();
 
+    if ( m_data->transitionId != transitionId )
+    {
+        /*
+            The set of animated controls does not change during
+            a transition, so we look it up only once.
+         */
+        m_data->transitionId = transitionId;
+        m_data->isTransitionAnimated = QskSkinTransition::isAnimated( item );
+
+        if ( !m_data->isTransitionAnimated )
+            return QVariant();
+    }
+
     QVariant v;
 
     auto a = aspect;
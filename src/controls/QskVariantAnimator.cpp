@@ -14,6 +14,7 @@
 #include "QskGradient.h"
 #include "QskMargins.h"
 #include "QskIntervalF.h"
+#include "QskRgbValue.h"
 #include "QskTextColors.h"
 
 // Even if we don't use the standard Qt animation system we
@@ -78,6 +79,88 @@ QSK_DECL_INSANE static inline QVariant qskInterpolate(
     return f( from.constData(), to.constData(), progress );
 }
 
+namespace
+{
+    /*
+        For the most common types we interpolate into the storage of
+        the current value, avoiding to create a new QVariant - usually
+        including a heap allocation - for each frame.
+     */
+
+    using TypedInterpolator = bool ( * )( const void*, const void*, qreal, void* );
+
+    template< typename T >
+    inline T qskInterpolated( const T& from, const T& to, qreal progress )
+    {
+        return from.interpolated( to, progress );
+    }
+
+    inline double qskInterpolated( double from, double to, qreal progress )
+    {
+        return from + ( to - from ) * progress;
+    }
+
+    inline float qskInterpolated( float from, float to, qreal progress )
+    {
+        return from + ( to - from ) * progress;
+    }
+
+    inline QColor qskInterpolated( const QColor& from, const QColor& to, qreal progress )
+    {
+        return QskRgb::interpolated( from, to, progress );
+    }
+
+    template< typename T >
+    bool qskInterpolateTyped( const void* from, const void* to,
+        qreal progress, void* value )
+    {
+        const auto v = qskInterpolated( *static_cast< const T* >( from ),
+            *static_cast< const T* >( to ), progress );
+
+        auto& current = *static_cast< T* >( value );
+        if ( current == v )
+            return false;
+
+        current = v;
+        return true;
+    }
+}
+
+static TypedInterpolator qskTypedInterpolator( int typeId )
+{
+    switch( typeId )
+    {
+        case QMetaType::Double:
+            return qskInterpolateTyped< double >;
+
+        case QMetaType::Float:
+            return qskInterpolateTyped< float >;
+
+        case QMetaType::QColor:
+            return qskInterpolateTyped< QColor >;
+    }
+
+    if ( typeId == qMetaTypeId< QskMargins >() )
+        return qskInterpolateTyped< QskMargins >;
+
+    if ( typeId == qMetaTypeId< QskBoxShapeMetrics >() )
+        return qskInterpolateTyped< QskBoxShapeMetrics >;
+
+    if ( typeId == qMetaTypeId< QskBoxBorderMetrics >() )
+        return qskInterpolateTyped< QskBoxBorderMetrics >;
+
+    if ( typeId == qMetaTypeId< QskBoxBorderColors >() )
+        return qskInterpolateTyped< QskBoxBorderColors >;
+
+    if ( typeId == qMetaTypeId< QskShadowMetrics >() )
+        return qskInterpolateTyped< QskShadowMetrics >;
+
+    if ( typeId == qMetaTypeId< QskGradient >() )
+        return qskInterpolateTyped< QskGradient >;
+
+    return nullptr;
+}
+
 #if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
 
 using QskMetaType = int;
@@ -105,6 +188,7 @@ static inline QVariant qskConvertedVariant( const QVariant& from, QskMetaType ty
 
 QskVariantAnimator::QskVariantAnimator()
     : m_interpolator( nullptr )
+    , m_typedInterpolator( nullptr )
 {
 }
 
@@ -172,6 +256,7 @@ bool QskVariantAnimator::convertValues( QVariant& v1, QVariant& v2 )
 void QskVariantAnimator::setup()
 {
     m_interpolator = nullptr;
+    m_typedInterpolator = nullptr;
 
     if ( convertValues( m_startValue, m_endValue ) )
     {
@@ -179,32 +264,64 @@ void QskVariantAnimator::setup()
         {
             const auto id = m_startValue.userType();
 
-            // all what has been registered by qRegisterAnimationInterpolator
-            m_interpolator = reinterpret_cast< void ( * )() >(
-                QVariantAnimationPrivate::getInterpolator( id ) );
+            m_typedInterpolator = qskTypedInterpolator( id );
+
+            if ( m_typedInterpolator == nullptr )
+            {
+                // all what has been registered by qRegisterAnimationInterpolator
+                m_interpolator = reinterpret_cast< void ( * )() >(
+                    QVariantAnimationPrivate::getInterpolator( id ) );
+            }
         }
     }
 
-    m_currentValue = m_interpolator ? m_startValue : m_endValue;
+    const bool hasInterpolator = m_interpolator || m_typedInterpolator;
+    m_currentValue = hasInterpolator ? m_startValue : m_endValue;
+
+    if ( m_typedInterpolator )
+    {
+        // detaching once, so that we can write to the value for all frames
+        ( void ) m_currentValue.data();
+    }
 }
 
 void QskVariantAnimator::advance( qreal progress )
 {
-    if ( m_interpolator )
+    ( void ) interpolate( progress );
+}
+
+bool QskVariantAnimator::interpolate( qreal progress )
+{
+    if ( m_typedInterpolator || m_interpolator )
     {
         if ( qFuzzyCompare( progress, 1.0 ) )
             progress = 1.0;
 
         Q_ASSERT( qskMetaType( m_startValue ) == qskMetaType( m_endValue ) );
 
-        m_currentValue = qskInterpolate( m_interpolator,
+        if ( m_typedInterpolator )
+        {
+            return m_typedInterpolator( m_startValue.constData(),
+                m_endValue.constData(), progress, m_currentValue.data() );
+        }
+
+        const auto value = qskInterpolate( m_interpolator,
             m_startValue, m_endValue, progress );
+
+        if ( value != m_currentValue )
+        {
+            m_currentValue = value;
+            return true;
+        }
     }
+
+    return false;
 }
 
 void QskVariantAnimator::done()
 {
     m_interpolator = nullptr;
+    m_typedInterpolator = nullptr;
 }
 
 bool QskVariantAnimator::maybeInterpolate(
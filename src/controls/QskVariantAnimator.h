@@ -16,7 +16,7 @@ class QSK_EXPORT QskVariantAnimator : public QskAnimator
     ~QskVariantAnimator() override;
 
     void setCurrentValue( const QVariant& );
-    QVariant currentValue() const;
+    const QVariant& currentValue() const;
 
     void setStartValue( const QVariant& );
     QVariant startValue() const;
@@ -32,12 +32,18 @@ class QSK_EXPORT QskVariantAnimator : public QskAnimator
     void advance( qreal value ) override;
     void done() override;
 
+    // returns true, when the current value has been modified
+    bool interpolate( qreal progress );
+
   private:
     QVariant m_startValue;
     QVariant m_endValue;
     QVariant m_currentValue;
 
     void ( *m_interpolator )();
+
+    // for types, that can be interpolated in place
+    bool ( *m_typedInterpolator )( const void*, const void*, qreal, void* );
 };
 
 inline QVariant QskVariantAnimator::startValue() const
@@ -50,7 +56,7 @@ inline QVariant QskVariantAnimator::endValue() const
     return m_endValue;
 }
 
-inline QVariant QskVariantAnimator::currentValue() const
+inline const QVariant& QskVariantAnimator::currentValue() const
 {
     return m_currentValue;
 }
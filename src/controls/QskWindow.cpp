@@ -10,9 +10,13 @@
 #include "QskSetup.h"
 #include "QskSkin.h"
 #include "QskSkinManager.h"
+#include "QskWindowProfiler.h"
 
 #include <qmath.h>
 #include <qpointer.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -132,6 +136,71 @@ static inline const QByteArray& qskVisualizationMode( const QQuickWindow* window
 #endif
 }
 
+static inline int qskItemDepth( const QQuickItem* item )
+{
+    int depth = 0;
+
+    for ( auto it = item->parentItem(); it != nullptr; it = it->parentItem() )
+        depth++;
+
+    return depth;
+}
+
+namespace
+{
+    class PolishQueue
+    {
+      public:
+        /*
+            A heap, where parents are taken before their children.
+            Items of the same depth are taken in the order of their
+            requests. The depth is calculated once, when enqueuing.
+         */
+
+        void enqueue( QQuickItem* item )
+        {
+            m_requests.append( { qskItemDepth( item ), m_sequence++, item } );
+            std::push_heap( m_requests.begin(), m_requests.end(), lessThan );
+        }
+
+        QQuickItem* dequeue()
+        {
+            std::pop_heap( m_requests.begin(), m_requests.end(), lessThan );
+
+            // the item might have been deleted in the meantime
+            QQuickItem* item = m_requests.last().item;
+            m_requests.removeLast();
+
+            return item;
+        }
+
+        inline bool isEmpty() const
+        {
+            return m_requests.isEmpty();
+        }
+
+      private:
+        struct Request
+        {
+            int depth;
+            int sequence;
+            QPointer< QQuickItem > item;
+        };
+
+        static bool lessThan( const Request& r1, const Request& r2 )
+        {
+            // true, when r1 has to be processed after r2
+            if ( r1.depth != r2.depth )
+                return r1.depth > r2.depth;
+
+            return r1.sequence > r2.sequence;
+        }
+
+        QVarLengthArray< Request, 64 > m_requests;
+        int m_sequence = 0;
+    };
+}
+
 class QskWindowPrivate : public QQuickWindowPrivate
 {
     Q_DECLARE_PUBLIC( QskWindow )
@@ -144,14 +213,93 @@ class QskWindowPrivate : public QQuickWindowPrivate
         , deleteOnClose( false )
         , autoLayoutChildren( true )
         , showedOnce( false )
+        , explicitDistanceFieldBoxes( false )
+        , distanceFieldBoxes( false )
+        , explicitLayeredClipping( false )
+        , layeredClipping( false )
+        , explicitFlatColorBoxes( false )
+        , flatColorBoxes( false )
     {
     }
 
+    void polishItemsTopDown()
+    {
+        /*
+            QQuickWindowPrivate::polishItems processes the items in the
+            order of their requests, so that children are often laid out
+            before their parents are assigning a new geometry, that triggers
+            another polish of the same children.
+
+            Instead we move the requests into a queue, that is processed
+            top-down. Requests, that are appended while polishing, are
+            inserted into the queue. As the items are still flagged as being
+            scheduled, duplicate requests are coalesced.
+         */
+
+        Q_Q( QskWindow );
+
+        polishCount = 0;
+
+        auto& items = itemsToPolish;
+
+        PolishQueue queue;
+
+        /*
+            Other items are left to QQuickWindowPrivate::polishItems,
+            as their private classes might have additional hooks.
+         */
+        QVarLengthArray< QPointer< QQuickItem >, 16 > otherItems;
+
+        while ( true )
+        {
+            for ( auto item : qAsConst( items ) )
+                queue.enqueue( item );
+
+            items.clear();
+
+            if ( queue.isEmpty() )
+                break;
+
+            auto last = queue.dequeue();
+            if ( last == nullptr || last->window() != q )
+            {
+                // deleted or moved to another window
+                continue;
+            }
+
+            auto item = qobject_cast< QskQuickItem* >( last );
+            if ( item == nullptr )
+            {
+                otherItems += last;
+                continue;
+            }
+
+            QQuickItemPrivate::get( item )->polishScheduled = false;
+
+            item->updatePolish();
+            polishCount++;
+        }
+
+        // polishItems takes from the end: keeping the top-down order
+        for ( int i = otherItems.count() - 1; i >= 0; i-- )
+        {
+            auto item = otherItems[i].data();
+            if ( item && item->window() == q )
+                items += item;
+        }
+
+        polishCount += items.count();
+
+        // processing the other items and updating the input method
+        polishItems();
+    }
+
 #ifdef QSK_DEBUG_RENDER_TIMING
     QElapsedTimer renderInterval;
 #endif
 
     QPointer< QskSkin > skin;
+    QskWindowProfiler* profiler = nullptr;
 
     ChildListener contentItemListener;
     QLocale locale;
@@ -161,15 +309,49 @@ class QskWindowPrivate : public QQuickWindowPrivate
 
     QskWindow::EventAcceptance eventAcceptance;
 
+    // number of polished items for the current frame
+    int polishCount = 0;
+
     bool explicitLocale : 1;
     bool deleteOnClose : 1;
     bool autoLayoutChildren : 1;
     bool showedOnce : 1;
+
+    bool explicitDistanceFieldBoxes : 1;
+    bool distanceFieldBoxes : 1;
+
+    bool explicitLayeredClipping : 1;
+    bool layeredClipping : 1;
+
+    bool explicitFlatColorBoxes : 1;
+    bool flatColorBoxes : 1;
 };
 
 QskWindow::QskWindow( QWindow* parent )
     : Inherited( *( new QskWindowPrivate() ), parent )
 {
+    initialize();
+}
+
+QskWindow::QskWindow( QQuickRenderControl* renderControl, QWindow* parent )
+    : Inherited( *( new QskWindowPrivate() ), parent )
+{
+    Q_D( QskWindow );
+
+    d->renderControl = renderControl;
+    d->init( this, renderControl );
+
+    initialize();
+}
+
+QskWindow::~QskWindow()
+{
+}
+
+void QskWindow::initialize()
+{
+    // the common part of the constructors
+
     QSurfaceFormat fmt = format();
     fmt.setSamples( 4 );
 #if 0
@@ -184,7 +366,7 @@ QskWindow::QskWindow( QWindow* parent )
      */
     contentItem()->setProperty( "locale", locale() );
 
-    if ( parent )
+    if ( parent() )
     {
         // also when the parent changes TODO ...
         qskResolveLocale( this );
@@ -194,19 +376,12 @@ QskWindow::QskWindow( QWindow* parent )
 
     if ( !qskEnforcedSkin )
         connect( this, &QQuickWindow::afterAnimating, this, &QskWindow::enforceSkin );
-}
 
-QskWindow::QskWindow( QQuickRenderControl* renderControl, QWindow* parent )
-    : QskWindow( parent )
-{
-    Q_D( QskWindow );
-
-    d->renderControl = renderControl;
-    d->init( this, renderControl );
-}
-
-QskWindow::~QskWindow()
-{
+    if ( const int mode = qEnvironmentVariableIntValue( "QSK_PROFILER" ) )
+    {
+        setProfilingEnabled( true );
+        profiler()->setOverlayEnabled( mode > 1 );
+    }
 }
 
 void QskWindow::setScreen( const QString& name )
@@ -284,7 +459,43 @@ void QskWindow::addItem( QQuickItem* item )
 void QskWindow::polishItems()
 {
     Q_D( QskWindow );
-    d->polishItems();
+    d->polishItemsTopDown();
+}
+
+int QskWindow::polishCount() const
+{
+    Q_D( const QskWindow );
+    return d->polishCount;
+}
+
+void QskWindow::setProfilingEnabled( bool on )
+{
+    Q_D( QskWindow );
+
+    if ( on == ( d->profiler != nullptr ) )
+        return;
+
+    if ( on )
+    {
+        d->profiler = new QskWindowProfiler( this );
+    }
+    else
+    {
+        delete d->profiler;
+        d->profiler = nullptr;
+    }
+}
+
+bool QskWindow::isProfilingEnabled() const
+{
+    Q_D( const QskWindow );
+    return d->profiler != nullptr;
+}
+
+QskWindowProfiler* QskWindow::profiler() const
+{
+    Q_D( const QskWindow );
+    return d->profiler;
 }
 
 bool QskWindow::event( QEvent* event )
@@ -368,6 +579,28 @@ bool QskWindow::event( QEvent* event )
                 qCDebug( logTiming() ) << "update timer - elapsed"
                     << d->renderInterval.restart() << objectName();
             }
+#endif
+            /*
+                The render loops are polishing the items, when handling
+                the update request. So we do our top-down pass before,
+                leaving an empty list to QQuickWindow.
+             */
+            if ( d->profiler )
+            {
+                QElapsedTimer timer;
+                timer.start();
+
+                d->profiler->beginFrame();
+                d->polishItemsTopDown();
+                d->profiler->polished( timer.nsecsElapsed(), d->polishCount );
+            }
+            else
+            {
+                d->polishItemsTopDown();
+            }
+
+#ifdef QSK_DEBUG_RENDER_TIMING
+            qCDebug( logTiming() ) << "polished items:" << d->polishCount;
 #endif
             break;
         }
@@ -686,6 +919,132 @@ QskSkin* QskWindow::skin() const
     return d_func()->skin;
 }
 
+void QskWindow::setDistanceFieldBoxes( bool on )
+{
+    Q_D( QskWindow );
+
+    const bool wasEnabled = hasDistanceFieldBoxes();
+
+    d->explicitDistanceFieldBoxes = true;
+    d->distanceFieldBoxes = on;
+
+    if ( on != wasEnabled )
+    {
+        // the skinlets replace the box nodes, when being updated
+        qskItemUpdateRecursive( contentItem() );
+    }
+}
+
+void QskWindow::resetDistanceFieldBoxes()
+{
+    Q_D( QskWindow );
+
+    const bool wasEnabled = hasDistanceFieldBoxes();
+
+    d->explicitDistanceFieldBoxes = false;
+    d->distanceFieldBoxes = false;
+
+    if ( hasDistanceFieldBoxes() != wasEnabled )
+        qskItemUpdateRecursive( contentItem() );
+}
+
+bool QskWindow::hasDistanceFieldBoxes() const
+{
+    Q_D( const QskWindow );
+
+    if ( d->explicitDistanceFieldBoxes )
+        return d->distanceFieldBoxes;
+
+    if ( auto skin = qskEffectiveSkin( this ) )
+        return skin->hasDistanceFieldBoxes();
+
+    return false;
+}
+
+void QskWindow::setLayeredClipping( bool on )
+{
+    Q_D( QskWindow );
+
+    const bool wasEnabled = hasLayeredClipping();
+
+    d->explicitLayeredClipping = true;
+    d->layeredClipping = on;
+
+    if ( on != wasEnabled )
+    {
+        // the skinlets switch the mode of the clip nodes, when being updated
+        qskItemUpdateRecursive( contentItem() );
+    }
+}
+
+void QskWindow::resetLayeredClipping()
+{
+    Q_D( QskWindow );
+
+    const bool wasEnabled = hasLayeredClipping();
+
+    d->explicitLayeredClipping = false;
+    d->layeredClipping = false;
+
+    if ( hasLayeredClipping() != wasEnabled )
+        qskItemUpdateRecursive( contentItem() );
+}
+
+bool QskWindow::hasLayeredClipping() const
+{
+    Q_D( const QskWindow );
+
+    if ( d->explicitLayeredClipping )
+        return d->layeredClipping;
+
+    if ( auto skin = qskEffectiveSkin( this ) )
+        return skin->hasLayeredClipping();
+
+    return false;
+}
+
+void QskWindow::setFlatColorBoxes( bool on )
+{
+    Q_D( QskWindow );
+
+    const bool wasEnabled = hasFlatColorBoxes();
+
+    d->explicitFlatColorBoxes = true;
+    d->flatColorBoxes = on;
+
+    if ( on != wasEnabled )
+    {
+        // the skinlets pass the color policy to the box nodes, when being updated
+        qskItemUpdateRecursive( contentItem() );
+    }
+}
+
+void QskWindow::resetFlatColorBoxes()
+{
+    Q_D( QskWindow );
+
+    const bool wasEnabled = hasFlatColorBoxes();
+
+    d->explicitFlatColorBoxes = false;
+    d->flatColorBoxes = false;
+
+    if ( hasFlatColorBoxes() != wasEnabled )
+        qskItemUpdateRecursive( contentItem() );
+}
+
+bool QskWindow::hasFlatColorBoxes() const
+{
+    Q_D( const QskWindow );
+
+    if ( d->explicitFlatColorBoxes )
+        return d->flatColorBoxes;
+
+    if ( auto skin = qskEffectiveSkin( this ) )
+        return skin->hasFlatColorBoxes();
+
+    return false;
+}
+
 QskSkin* qskEffectiveSkin( const QQuickWindow* window )
 {
     if ( auto w = qobject_cast< const QskWindow* >( window ) )
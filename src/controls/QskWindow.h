@@ -10,6 +10,7 @@
 #include <qquickwindow.h>
 
 class QskWindowPrivate;
+class QskWindowProfiler;
 class QskObjectAttributes;
 class QskSkin;
 
@@ -63,6 +64,19 @@ class QSK_EXPORT QskWindow : public QQuickWindow
 
     void polishItems();
 
+    // number of items, that have been polished by the last polish pass
+    int polishCount() const;
+
+    /*
+        Opt-in profiling of the frames and the costs of the items.
+        Can also be enabled by setting QSK_PROFILER to 1 - or 2 for
+        having an on-screen overlay.
+     */
+    void setProfilingEnabled( bool );
+    bool isProfilingEnabled() const;
+
+    QskWindowProfiler* profiler() const;
+
     void setCustomRenderMode( const char* mode );
     const char* customRenderMode() const;
 
@@ -75,6 +89,21 @@ class QSK_EXPORT QskWindow : public QQuickWindow
     void setSkin( const QString& );
     QskSkin* skin() const;
 
+    // falls back to QskSkin::hasDistanceFieldBoxes, when not being set
+    void setDistanceFieldBoxes( bool );
+    void resetDistanceFieldBoxes();
+    bool hasDistanceFieldBoxes() const;
+
+    // falls back to QskSkin::hasLayeredClipping, when not being set
+    void setLayeredClipping( bool );
+    void resetLayeredClipping();
+    bool hasLayeredClipping() const;
+
+    // falls back to QskSkin::hasFlatColorBoxes, when not being set
+    void setFlatColorBoxes( bool );
+    void resetFlatColorBoxes();
+    bool hasFlatColorBoxes() const;
+
   Q_SIGNALS:
     void localeChanged( const QLocale& );
     void autoLayoutChildrenChanged();
@@ -95,6 +124,7 @@ class QSK_EXPORT QskWindow : public QQuickWindow
     virtual void ensureFocus( Qt::FocusReason );
 
   private:
+    void initialize();
     void enforceSkin();
 
     Q_DECLARE_PRIVATE( QskWindow )
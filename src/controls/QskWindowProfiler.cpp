@@ -0,0 +1,518 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskWindowProfiler.h"
+#include "QskWindow.h"
+#include "QskSkinnable.h"
+#include "QskTextLabel.h"
+#include "QskQuick.h"
+#include "QskVertex.h"
+
+#include <qatomic.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qpointer.h>
+#include <qthread.h>
+#include <qtimer.h>
+
+#include <algorithm>
+
+static QAtomicInt qskActiveProfilers;
+
+static inline double qskMilliseconds( qint64 nsecs )
+{
+    return nsecs / 1.0e6;
+}
+
+static QString qskOverlayText(
+    const QskWindowProfiler::FrameStatistics& frame,
+    const QVector< QskWindowProfiler::ClassStatistics >& classes )
+{
+    QString text = QStringLiteral(
+            "frame: %1ms, polish: %2ms, sync: %3ms, render: %4ms, allocations: %5" )
+        .arg( qskMilliseconds( frame.frameTime ), 0, 'f', 2 )
+        .arg( qskMilliseconds( frame.polishTime ), 0, 'f', 2 )
+        .arg( qskMilliseconds( frame.syncTime ), 0, 'f', 2 )
+        .arg( qskMilliseconds( frame.renderTime ), 0, 'f', 2 )
+        .arg( frame.geometryAllocations );
+
+    const int count = qMin( classes.size(), 5 );
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto& stats = classes[ i ];
+
+        text += QStringLiteral( "\n%1: %2ms" )
+            .arg( QString::fromLatin1( stats.className ) )
+            .arg( qskMilliseconds( stats.totalTime() ), 0, 'f', 2 );
+    }
+
+    return text;
+}
+
+class QskWindowProfiler::PrivateData
+{
+  public:
+    PrivateData( QskWindow* window )
+        : window( window )
+    {
+        clock.start();
+    }
+
+    QskWindow* window;
+
+    QElapsedTimer clock;
+
+    /*
+        Instead of locking we collect the costs separately for the GUI
+        and the scene graph thread. Items are updated from the scene graph
+        thread only while synchronizing - when the GUI thread is blocked.
+        So reading both tables from the GUI thread is safe.
+     */
+    typedef QHash< const char*, ClassStatistics > ClassTable;
+    ClassTable classes[ 2 ];
+
+    // only accessed from the GUI thread: see appendFrame()
+    QVector< FrameStatistics > frames;
+    int historySize = 120;
+
+    /*
+        With the threaded render loop the next frame might be
+        polished, while the previous one is still being rendered.
+        polishedFrame is handed over, while synchronizing.
+     */
+    FrameStatistics polishedFrame;
+    qint64 polishStart = -1;
+    bool polishedItems = false;
+
+    FrameStatistics renderedFrame;
+    qint64 frameStart = -1;
+    qint64 syncStart = -1;
+    qint64 renderStart = -1;
+    bool renderedItems = false;
+
+    /*
+        The counter is shared by all windows. With several windows being
+        synchronized at the same time the numbers are approximations only.
+     */
+    int syncAllocations = 0;
+
+    QPointer< QskTextLabel > overlay;
+    const QQuickItem* overlayItem = nullptr; // for the scene graph thread
+
+    QTimer overlayTimer;
+    qint64 overlayUpdate = -1;
+    bool overlayDirty = false;
+};
+
+QskWindowProfiler::QskWindowProfiler( QskWindow* window )
+    : Inherited( window )
+    , m_data( new PrivateData( window ) )
+{
+    qskActiveProfilers.ref();
+
+    /*
+        The scene graph signals are emitted from the render thread
+        and have to be handled there.
+     */
+    connect( window, &QQuickWindow::beforeSynchronizing,
+        this, &QskWindowProfiler::beforeSynchronizing, Qt::DirectConnection );
+
+    connect( window, &QQuickWindow::afterSynchronizing,
+        this, &QskWindowProfiler::afterSynchronizing, Qt::DirectConnection );
+
+    connect( window, &QQuickWindow::beforeRendering,
+        this, &QskWindowProfiler::beforeRendering, Qt::DirectConnection );
+
+    connect( window, &QQuickWindow::afterRendering,
+        this, &QskWindowProfiler::afterRendering, Qt::DirectConnection );
+
+    connect( window, &QQuickWindow::frameSwapped,
+        this, &QskWindowProfiler::frameSwapped, Qt::DirectConnection );
+
+    m_data->overlayTimer.setSingleShot( true );
+
+    connect( &m_data->overlayTimer, &QTimer::timeout,
+        this, &QskWindowProfiler::updateOverlay );
+}
+
+QskWindowProfiler::~QskWindowProfiler()
+{
+    delete m_data->overlay;
+    qskActiveProfilers.deref();
+}
+
+QskWindow* QskWindowProfiler::window() const
+{
+    return m_data->window;
+}
+
+bool QskWindowProfiler::isActive()
+{
+    return qskActiveProfilers.loadRelaxed() > 0;
+}
+
+void QskWindowProfiler::setOverlayEnabled( bool on )
+{
+    if ( on == isOverlayEnabled() )
+        return;
+
+    if ( on )
+    {
+        auto label = new QskTextLabel( m_data->window->contentItem() );
+        label->setObjectName( QStringLiteral( "QskWindowProfilerOverlay" ) );
+        label->setPanel( true );
+        label->setZ( 1e6 );
+
+        qskSetPlacementPolicy( label, QskPlacementPolicy::Ignore );
+
+        m_data->overlay = label;
+        m_data->overlayItem = label;
+
+        m_data->overlayDirty = true;
+        updateOverlay();
+    }
+    else
+    {
+        m_data->overlayItem = nullptr;
+        delete m_data->overlay;
+    }
+}
+
+bool QskWindowProfiler::isOverlayEnabled() const
+{
+    return m_data->overlay != nullptr;
+}
+
+void QskWindowProfiler::setFrameHistorySize( int size )
+{
+    size = qMax( size, 1 );
+
+    m_data->historySize = size;
+
+    auto& frames = m_data->frames;
+    if ( frames.size() > size )
+        frames.remove( 0, frames.size() - size );
+}
+
+int QskWindowProfiler::frameHistorySize() const
+{
+    return m_data->historySize;
+}
+
+QskWindowProfiler::FrameStatistics QskWindowProfiler::lastFrame() const
+{
+    const auto& frames = m_data->frames;
+    return frames.isEmpty() ? FrameStatistics() : frames.last();
+}
+
+QVector< QskWindowProfiler::FrameStatistics > QskWindowProfiler::frames() const
+{
+    return m_data->frames;
+}
+
+QVector< QskWindowProfiler::ClassStatistics > QskWindowProfiler::classStatistics() const
+{
+    // merging the costs of both threads
+    auto table = m_data->classes[ 0 ];
+
+    for ( const auto& stats : qAsConst( m_data->classes[ 1 ] ) )
+    {
+        auto& merged = table[ stats.className ];
+        merged.className = stats.className;
+
+        for ( int i = 0; i < CostCount; i++ )
+        {
+            merged.time[ i ] += stats.time[ i ];
+            merged.count[ i ] += stats.count[ i ];
+        }
+    }
+
+    QVector< ClassStatistics > classes;
+    classes.reserve( table.size() );
+
+    for ( const auto& stats : qAsConst( table ) )
+        classes += stats;
+
+    std::sort( classes.begin(), classes.end(),
+        []( const ClassStatistics& s1, const ClassStatistics& s2 )
+        { return s1.totalTime() > s2.totalTime(); } );
+
+    return classes;
+}
+
+void QskWindowProfiler::reset()
+{
+    m_data->classes[ 0 ].clear();
+    m_data->classes[ 1 ].clear();
+    m_data->frames.clear();
+}
+
+QByteArray QskWindowProfiler::toJson() const
+{
+    static const char* costNames[] = { "polish", "updateNode", "resolveHint" };
+
+    QJsonArray jsonFrames;
+
+    const auto frames = this->frames();
+    for ( const auto& frame : frames )
+    {
+        QJsonObject object;
+        object[ QStringLiteral( "frame" ) ] = qskMilliseconds( frame.frameTime );
+        object[ QStringLiteral( "polish" ) ] = qskMilliseconds( frame.polishTime );
+        object[ QStringLiteral( "sync" ) ] = qskMilliseconds( frame.syncTime );
+        object[ QStringLiteral( "render" ) ] = qskMilliseconds( frame.renderTime );
+        object[ QStringLiteral( "polishedItems" ) ] = frame.polishCount;
+        object[ QStringLiteral( "updatedNodes" ) ] = frame.nodeCount;
+        object[ QStringLiteral( "geometryAllocations" ) ] = frame.geometryAllocations;
+
+        jsonFrames += object;
+    }
+
+    QJsonArray jsonClasses;
+
+    const auto classes = classStatistics();
+    for ( const auto& stats : classes )
+    {
+        QJsonObject object;
+        object[ QStringLiteral( "class" ) ] = QString::fromLatin1( stats.className );
+        object[ QStringLiteral( "total" ) ] = qskMilliseconds( stats.totalTime() );
+
+        for ( int i = 0; i < CostCount; i++ )
+        {
+            QJsonObject cost;
+            cost[ QStringLiteral( "time" ) ] = qskMilliseconds( stats.time[ i ] );
+            cost[ QStringLiteral( "count" ) ] = stats.count[ i ];
+
+            object[ QLatin1String( costNames[ i ] ) ] = cost;
+        }
+
+        jsonClasses += object;
+    }
+
+    QJsonObject json;
+    json[ QStringLiteral( "window" ) ] = m_data->window->objectName();
+    json[ QStringLiteral( "unit" ) ] = QStringLiteral( "ms" );
+    json[ QStringLiteral( "frames" ) ] = jsonFrames;
+    json[ QStringLiteral( "classes" ) ] = jsonClasses;
+
+    return QJsonDocument( json ).toJson();
+}
+
+bool QskWindowProfiler::dumpJson( const QString& fileName ) const
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        return false;
+
+    return file.write( toJson() ) >= 0;
+}
+
+void QskWindowProfiler::addCost( const QQuickItem* item, Cost cost, qint64 time )
+{
+    const bool isGuiThread = ( QThread::currentThread() == thread() );
+
+    const auto className = item->metaObject()->className();
+
+    auto& stats = m_data->classes[ isGuiThread ? 0 : 1 ][ className ];
+    stats.className = className;
+    stats.time[ cost ] += time;
+    stats.count[ cost ]++;
+
+    switch( cost )
+    {
+        case Polish:
+        {
+            m_data->polishedItems = true;
+            break;
+        }
+        case UpdateNode:
+        {
+            m_data->renderedFrame.nodeCount++;
+            m_data->renderedItems = true;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void QskWindowProfiler::beginFrame()
+{
+    if ( m_data->polishStart < 0 )
+        m_data->polishStart = m_data->clock.nsecsElapsed();
+}
+
+void QskWindowProfiler::polished( qint64 time, int count )
+{
+    m_data->polishedFrame.polishTime += time;
+    m_data->polishedFrame.polishCount += count;
+}
+
+void QskWindowProfiler::beforeSynchronizing()
+{
+    const auto now = m_data->clock.nsecsElapsed();
+
+    // the GUI thread is blocked, while synchronizing
+    m_data->renderedFrame = m_data->polishedFrame;
+    m_data->renderedItems = m_data->polishedItems;
+    m_data->frameStart = ( m_data->polishStart >= 0 ) ? m_data->polishStart : now;
+
+    m_data->polishedFrame = FrameStatistics();
+    m_data->polishedItems = false;
+    m_data->polishStart = -1;
+
+    m_data->syncStart = now;
+    m_data->syncAllocations = QskVertex::allocationCount();
+}
+
+void QskWindowProfiler::afterSynchronizing()
+{
+    if ( m_data->syncStart >= 0 )
+    {
+        m_data->renderedFrame.syncTime =
+            m_data->clock.nsecsElapsed() - m_data->syncStart;
+
+        m_data->renderedFrame.geometryAllocations =
+            QskVertex::allocationCount() - m_data->syncAllocations;
+    }
+}
+
+void QskWindowProfiler::beforeRendering()
+{
+    m_data->renderStart = m_data->clock.nsecsElapsed();
+}
+
+void QskWindowProfiler::afterRendering()
+{
+    if ( m_data->renderStart >= 0 )
+    {
+        m_data->renderedFrame.renderTime =
+            m_data->clock.nsecsElapsed() - m_data->renderStart;
+    }
+}
+
+void QskWindowProfiler::frameSwapped()
+{
+    if ( m_data->frameStart < 0 )
+        return;
+
+    auto frame = m_data->renderedFrame;
+    frame.frameTime = m_data->clock.nsecsElapsed() - m_data->frameStart;
+
+    const bool hasItemUpdates = m_data->renderedItems;
+
+    m_data->renderedFrame = FrameStatistics();
+    m_data->renderedItems = false;
+    m_data->frameStart = m_data->syncStart = m_data->renderStart = -1;
+
+    // the frames are stored in the GUI thread
+    QMetaObject::invokeMethod( this,
+        [this, frame, hasItemUpdates] { appendFrame( frame, hasItemUpdates ); },
+        Qt::QueuedConnection );
+}
+
+void QskWindowProfiler::appendFrame(
+    const FrameStatistics& frame, bool hasItemUpdates )
+{
+    auto& frames = m_data->frames;
+    if ( frames.size() >= m_data->historySize )
+        frames.removeFirst();
+
+    frames += frame;
+
+    /*
+        Frames, where nothing but the overlay has been updated,
+        are not shown. Otherwise the overlay would keep
+        the window busy forever.
+     */
+    if ( hasItemUpdates )
+    {
+        m_data->overlayDirty = true;
+        updateOverlay();
+    }
+
+    Q_EMIT frameCompleted();
+}
+
+void QskWindowProfiler::updateOverlay()
+{
+    auto overlay = m_data->overlay.data();
+    if ( overlay == nullptr || !m_data->overlayDirty )
+        return;
+
+    /*
+        Changing the text results in another frame, so we
+        limit the updates to avoid rendering for the overlay only.
+     */
+    const auto now = m_data->clock.elapsed();
+
+    if ( m_data->overlayUpdate >= 0 )
+    {
+        const auto elapsed = now - m_data->overlayUpdate;
+        if ( elapsed < 500 )
+        {
+            if ( !m_data->overlayTimer.isActive() )
+                m_data->overlayTimer.start( 500 - elapsed );
+
+            return;
+        }
+    }
+
+    m_data->overlayUpdate = now;
+    m_data->overlayDirty = false;
+
+    overlay->setText( qskOverlayText( lastFrame(), classStatistics() ) );
+    overlay->setGeometry( QRectF( QPointF(), overlay->sizeConstraint() ) );
+}
+
+QskWindowProfiler::Measurement::Measurement( const QQuickItem* item, Cost cost )
+    : m_profiler( nullptr )
+    , m_item( nullptr )
+    , m_cost( cost )
+{
+    if ( QskWindowProfiler::isActive() )
+        start( item );
+}
+
+QskWindowProfiler::Measurement::Measurement( const QskSkinnable* skinnable, Cost cost )
+    : m_profiler( nullptr )
+    , m_item( nullptr )
+    , m_cost( cost )
+{
+    // checking the atomic first, as this constructor is called for each hint
+    if ( QskWindowProfiler::isActive() && skinnable )
+        start( skinnable->owningItem() );
+}
+
+void QskWindowProfiler::Measurement::start( const QQuickItem* item )
+{
+    if ( item == nullptr )
+        return;
+
+    if ( auto window = qobject_cast< const QskWindow* >( item->window() ) )
+    {
+        auto profiler = window->profiler();
+
+        // the costs of the overlay are not of interest
+        if ( profiler && item != profiler->m_data->overlayItem )
+        {
+            m_profiler = profiler;
+            m_item = item;
+
+            m_timer.start();
+        }
+    }
+}
+
+QskWindowProfiler::Measurement::~Measurement()
+{
+    if ( m_profiler )
+        m_profiler->addCost( m_item, m_cost, m_timer.nsecsElapsed() );
+}
+
+#include "moc_QskWindowProfiler.cpp"
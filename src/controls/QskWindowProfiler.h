@@ -0,0 +1,150 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_WINDOW_PROFILER_H
+#define QSK_WINDOW_PROFILER_H
+
+#include "QskGlobal.h"
+
+#include <qobject.h>
+#include <qelapsedtimer.h>
+#include <qvector.h>
+#include <memory>
+
+class QskWindow;
+class QskSkinnable;
+class QQuickItem;
+
+/*
+    QskWindowProfiler measures the phases of the frames of a QskWindow
+    and the costs of the items, accumulated per class.
+
+    Times are in nanoseconds. The costs for resolving skin hints are
+    also included in the costs for polishing/updating the nodes.
+ */
+class QSK_EXPORT QskWindowProfiler : public QObject
+{
+    Q_OBJECT
+
+    using Inherited = QObject;
+
+  public:
+    enum Cost
+    {
+        Polish,
+        UpdateNode,
+        ResolveHint,
+
+        CostCount
+    };
+
+    class Measurement;
+
+    class FrameStatistics
+    {
+      public:
+        qint64 polishTime = 0;
+        qint64 syncTime = 0;
+        qint64 renderTime = 0;
+        qint64 frameTime = 0; // from the update request until swapping
+
+        int polishCount = 0;
+        int nodeCount = 0;
+
+        // vertex buffers, that had to be allocated: see QskVertex::allocateVertexes
+        int geometryAllocations = 0;
+    };
+
+    class ClassStatistics
+    {
+      public:
+        qint64 totalTime() const
+        {
+            return time[ Polish ] + time[ UpdateNode ];
+        }
+
+        const char* className = nullptr;
+
+        qint64 time[ CostCount ] = {};
+        int count[ CostCount ] = {};
+    };
+
+    QskWindowProfiler( QskWindow* );
+    ~QskWindowProfiler() override;
+
+    QskWindow* window() const;
+
+    void setOverlayEnabled( bool );
+    bool isOverlayEnabled() const;
+
+    // the number of frames, that are stored
+    void setFrameHistorySize( int );
+    int frameHistorySize() const;
+
+    FrameStatistics lastFrame() const;
+
+    // from the oldest to the most recent frame
+    QVector< FrameStatistics > frames() const;
+
+    // ordered by the total time, most expensive classes first
+    QVector< ClassStatistics > classStatistics() const;
+
+    QByteArray toJson() const;
+    bool dumpJson( const QString& fileName ) const;
+
+    // true, when any window is profiled
+    static bool isActive();
+
+  public Q_SLOTS:
+    void reset();
+
+  Q_SIGNALS:
+    void frameCompleted();
+
+  private:
+    void addCost( const QQuickItem*, Cost, qint64 );
+    void appendFrame( const FrameStatistics&, bool hasItemUpdates );
+
+    void beginFrame();
+    void polished( qint64 time, int count );
+
+    void beforeSynchronizing();
+    void afterSynchronizing();
+    void beforeRendering();
+    void afterRendering();
+    void frameSwapped();
+
+    void updateOverlay();
+
+    friend class QskWindow;
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+/*
+    Measuring the costs of an item, when its window is profiled
+ */
+class QSK_EXPORT QskWindowProfiler::Measurement
+{
+  public:
+    Measurement( const QQuickItem*, Cost );
+    Measurement( const QskSkinnable*, Cost );
+
+    ~Measurement();
+
+  private:
+    Q_DISABLE_COPY( Measurement )
+
+    void start( const QQuickItem* );
+
+    QskWindowProfiler* m_profiler;
+    const QQuickItem* m_item;
+    const Cost m_cost;
+
+    QElapsedTimer m_timer;
+};
+
+#endif
@@ -0,0 +1,701 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskAnchorBox.h"
+#include "QskEvent.h"
+#include "QskQuick.h"
+
+#include "kiwi/Solver.h"
+#include "kiwi/Constraint.h"
+#include "kiwi/Variable.h"
+#include "kiwi/Expression.h"
+
+#include <vector>
+#include <map>
+#include <limits>
+
+using namespace Kiwi;
+
+/*
+     The solver seems to run into overflows with
+     std::numeric_limits< unsigned float >::max()
+ */
+static const qreal qskMaxLength = std::numeric_limits< unsigned int >::max();
+
+static inline Qt::Orientation qskOrientation( int edge )
+{
+    return ( edge <= Qt::AnchorRight ) ? Qt::Horizontal : Qt::Vertical;
+}
+
+static inline Qt::AnchorPoint qskAnchorPoint(
+    Qt::Corner corner, Qt::Orientation orientation )
+{
+    if ( orientation == Qt::Horizontal )
+        return ( corner & 0x1 ) ? Qt::AnchorRight : Qt::AnchorLeft;
+    else
+        return ( corner >= 0x2 ) ? Qt::AnchorBottom : Qt::AnchorTop;
+}
+
+namespace
+{
+    class Geometry
+    {
+      public:
+        Expression expressionAt( int anchorPoint ) const
+        {
+            switch( anchorPoint )
+            {
+                case Qt::AnchorLeft:
+                    return Term( m_left );
+
+                case Qt::AnchorHorizontalCenter:
+                    return centerH();
+
+                case Qt::AnchorRight:
+                    return right();
+
+                case Qt::AnchorTop:
+                    return Term( m_top );
+
+                case Qt::AnchorVerticalCenter:
+                    return centerV();
+
+                case Qt::AnchorBottom:
+                    return bottom();
+            }
+
+            return Expression();
+        }
+
+        inline const Variable& length( Qt::Orientation orientation ) const
+        {
+            return ( orientation == Qt::Horizontal ) ? m_width : m_height;
+        }
+
+        inline QRectF rect() const
+        {
+            return QRectF( m_left.value(), m_top.value(),
+                m_width.value(), m_height.value() );
+        }
+
+        inline Expression centerH() const { return m_left + 0.5 * m_width; }
+        inline Expression centerV() const { return m_top + 0.5 * m_height; }
+        inline Expression right() const { return m_left + m_width; }
+        inline Expression bottom() const { return m_top + m_height; }
+
+        inline const Variable& width() const { return m_width; }
+        inline const Variable& height() const { return m_height; }
+
+      private:
+        Variable m_left, m_top, m_width, m_height;
+    };
+
+    class Anchor
+    {
+      public:
+        QQuickItem* item1 = nullptr;
+        Qt::AnchorPoint edge1;
+
+        QQuickItem* item2 = nullptr;
+        Qt::AnchorPoint edge2;
+    };
+
+    class Hints
+    {
+      public:
+        inline bool operator!=( const Hints& other ) const
+        {
+            return ( minimum != other.minimum ) || ( preferred != other.preferred )
+                || ( maximum != other.maximum );
+        }
+
+        QSizeF minimum;
+        QSizeF preferred;
+        QSizeF maximum;
+    };
+
+    /*
+        Each solver has its own set of variables, so that the
+        solutions remain valid, until the solver is asked again.
+     */
+    class LayoutSolver : public Solver
+    {
+      public:
+        LayoutSolver( bool layoutChildren, const QVector< Anchor >&,
+            const std::map< QQuickItem*, Hints >& );
+
+        void setHints( QQuickItem*, const Hints& );
+        void setEditable( bool );
+
+        QSizeF resolvedSize();
+        QSizeF resolvedSize( const QSizeF& );
+        QSizeF resolvedSize( Qt::SizeHint, Qt::Orientation, qreal length );
+
+        const std::map< QQuickItem*, Geometry >& geometries() const
+        {
+            return m_geometries;
+        }
+
+      private:
+        void addSizeConstraints( std::vector< Constraint >&, const Geometry&,
+            const QSizeF&, RelationalOperator, double strength );
+
+        Variable m_width, m_height;
+        QSizeF m_suggestedSize;
+
+        std::map< QQuickItem*, Geometry > m_geometries;
+        std::map< QQuickItem*, std::vector< Constraint > > m_hintConstraints;
+    };
+}
+
+LayoutSolver::LayoutSolver( bool layoutChildren,
+    const QVector< Anchor >& anchors, const std::map< QQuickItem*, Hints >& hints )
+{
+    for ( const auto& anchor : anchors )
+    {
+        const auto& r1 = m_geometries[ anchor.item1 ];
+        const auto expr1 = r1.expressionAt( anchor.edge1 );
+
+        if ( anchor.item2 == nullptr )
+        {
+            Expression expr2;
+
+            switch( anchor.edge2 )
+            {
+                case Qt::AnchorLeft:
+                case Qt::AnchorTop:
+                    expr2 = 0;
+                    break;
+
+                case Qt::AnchorHorizontalCenter:
+                    expr2 = Term( 0.5 * m_width );
+                    break;
+
+                case Qt::AnchorRight:
+                    expr2 = Term( m_width );
+                    break;
+
+                case Qt::AnchorVerticalCenter:
+                    expr2 = Term( 0.5 * m_height );
+                    break;
+
+                case Qt::AnchorBottom:
+                    expr2 = Term( m_height );
+                    break;
+            }
+
+            addConstraint( expr1 == expr2 );
+        }
+        else
+        {
+            const auto& r2 = m_geometries[ anchor.item2 ];
+            const auto expr2 = r2.expressionAt( anchor.edge2 );
+
+            addConstraint( expr1 == expr2 );
+
+            if ( layoutChildren )
+            {
+                const auto o = qskOrientation( anchor.edge1 );
+
+                /*
+                    A constraint with medium strength to make anchored item
+                    being stretched according to their stretch factors s1, s2.
+                    ( For the moment we don't support having specific factors. )
+                 */
+                const auto s1 = 1.0;
+                const auto s2 = 1.0;
+
+                Constraint c( r1.length( o ) * s1 == r2.length( o ) * s2, Strength::medium );
+                addConstraint( c );
+            }
+        }
+    }
+
+    for ( auto it = hints.begin(); it != hints.end(); ++it )
+        setHints( it->first, it->second );
+}
+
+void LayoutSolver::setHints( QQuickItem* item, const Hints& hints )
+{
+    auto it = m_geometries.find( item );
+    if ( it == m_geometries.end() )
+        return;
+
+    /*
+        Only the constraints of the item are replaced, all other
+        rows of the tableau remain unaffected.
+     */
+
+    auto& constraints = m_hintConstraints[ item ];
+
+    for ( const auto& constraint : constraints )
+        removeConstraint( constraint );
+
+    constraints.clear();
+
+    const auto& geometry = it->second;
+
+    addSizeConstraints( constraints, geometry,
+        hints.minimum, OP_GE, Strength::required );
+
+    addSizeConstraints( constraints, geometry,
+        hints.maximum, OP_LE, Strength::required );
+
+    addSizeConstraints( constraints, geometry,
+        hints.preferred, OP_EQ, Strength::strong );
+}
+
+void LayoutSolver::addSizeConstraints( std::vector< Constraint >& constraints,
+    const Geometry& geometry, const QSizeF& size,
+    RelationalOperator op, double strength )
+{
+    if ( size.width() >= 0.0 )
+    {
+        const Constraint c( geometry.width() - size.width(), op, strength );
+
+        addConstraint( c );
+        constraints.push_back( c );
+    }
+
+    if ( size.height() >= 0.0 )
+    {
+        const Constraint c( geometry.height() - size.height(), op, strength );
+
+        addConstraint( c );
+        constraints.push_back( c );
+    }
+}
+
+void LayoutSolver::setEditable( bool on )
+{
+    if ( on == hasEditVariable( m_width ) )
+        return;
+
+    if ( on )
+    {
+        const double strength = 0.9 * Strength::required;
+
+        addEditVariable( m_width, strength );
+        addEditVariable( m_height, strength );
+    }
+    else
+    {
+        removeEditVariable( m_width );
+        removeEditVariable( m_height );
+    }
+
+    m_suggestedSize = QSizeF();
+}
+
+QSizeF LayoutSolver::resolvedSize()
+{
+    updateVariables();
+    return QSizeF( m_width.value(), m_height.value() );
+}
+
+QSizeF LayoutSolver::resolvedSize( const QSizeF& size )
+{
+    /*
+        Suggesting values for edit variables is the incremental
+        path of the solver: only the rows depending on the
+        size of the box are updated.
+     */
+    if ( size.width() != m_suggestedSize.width() )
+        suggestValue( m_width, size.width() );
+
+    if ( size.height() != m_suggestedSize.height() )
+        suggestValue( m_height, size.height() );
+
+    m_suggestedSize = size;
+
+    return resolvedSize();
+}
+
+QSizeF LayoutSolver::resolvedSize(
+    Qt::SizeHint which, Qt::Orientation orientation, qreal length )
+{
+    /*
+        The constrained length is fixed by a temporary constraint, while
+        the other one is minimized/maximized by suggesting a value
+        for its edit variable.
+     */
+    setEditable( false );
+
+    const bool isHorizontal = ( orientation == Qt::Horizontal );
+
+    const auto& fixed = isHorizontal ? m_width : m_height;
+    const auto& variable = isHorizontal ? m_height : m_width;
+
+    /*
+        A length outside of the min/max hints would make a required
+        constraint unsatisfiable. So we use a strength below required,
+        but above the one for the edit variable of the other length.
+     */
+    const Constraint constraint( fixed - length, OP_EQ, 0.95 * Strength::required );
+    addConstraint( constraint );
+
+    if ( which != Qt::PreferredSize )
+    {
+        addEditVariable( variable, 0.9 * Strength::required );
+        suggestValue( variable, ( which == Qt::MinimumSize ) ? 0.0 : qskMaxLength );
+    }
+
+    const auto size = resolvedSize();
+
+    if ( which != Qt::PreferredSize )
+        removeEditVariable( variable );
+
+    removeConstraint( constraint );
+
+    return size;
+}
+
+static inline Hints qskItemHints( const QQuickItem* item )
+{
+    Hints hints;
+    hints.minimum = qskSizeConstraint( item, Qt::MinimumSize );
+    hints.preferred = qskSizeConstraint( item, Qt::PreferredSize );
+    hints.maximum = qskSizeConstraint( item, Qt::MaximumSize );
+
+    return hints;
+}
+
+class QskAnchorBox::PrivateData
+{
+  public:
+    void resetSolvers()
+    {
+        hintsSolver.reset();
+        layoutSolver.reset();
+
+        hasValidHints = false;
+        layoutSize = QSizeF();
+    }
+
+    QVector< Anchor > anchors;
+    std::map< QQuickItem*, Hints > itemHints;
+
+    std::unique_ptr< LayoutSolver > hintsSolver;
+    std::unique_ptr< LayoutSolver > layoutSolver;
+
+    QSizeF boxHints[3];
+    bool hasValidHints = false;
+
+    // the size, that is resolved by layoutSolver
+    QSizeF layoutSize;
+};
+
+QskAnchorBox::QskAnchorBox( QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData )
+{
+}
+
+QskAnchorBox::~QskAnchorBox()
+{
+}
+
+void QskAnchorBox::addAnchors( QQuickItem* item, Qt::Orientations orientations )
+{
+    addAnchors( item, this, orientations );
+}
+
+void QskAnchorBox::addAnchors( QQuickItem* item1,
+    QQuickItem* item2, Qt::Orientations orientations )
+{
+    if ( orientations & Qt::Horizontal )
+    {
+        addAnchor( item1, Qt::AnchorLeft, item2, Qt::AnchorLeft );
+        addAnchor( item1, Qt::AnchorRight, item2, Qt::AnchorRight );
+    }
+
+    if ( orientations & Qt::Vertical )
+    {
+        addAnchor( item1, Qt::AnchorTop, item2, Qt::AnchorTop );
+        addAnchor( item1, Qt::AnchorBottom, item2, Qt::AnchorBottom );
+    }
+}
+
+void QskAnchorBox::addAnchors( QQuickItem* item, Qt::Corner corner )
+{
+    addAnchors( item, corner, this, corner );
+}
+
+void QskAnchorBox::addAnchors( QQuickItem* item1,
+    Qt::Corner corner1, QQuickItem* item2, Qt::Corner corner2 )
+{
+    addAnchor( item1, qskAnchorPoint( corner1, Qt::Horizontal ),
+        item2, qskAnchorPoint( corner2, Qt::Horizontal ) );
+
+    addAnchor( item1, qskAnchorPoint( corner1, Qt::Vertical ),
+        item2, qskAnchorPoint( corner2, Qt::Vertical ) );
+}
+
+void QskAnchorBox::addAnchor( QQuickItem* item,
+    Qt::AnchorPoint edge1, Qt::AnchorPoint edge2 )
+{
+    addAnchor( item, edge1, this, edge2 );
+}
+
+void QskAnchorBox::addAnchor( QQuickItem* item1, Qt::AnchorPoint edge1,
+    QQuickItem* item2, Qt::AnchorPoint edge2 )
+{
+    if ( item1 == item2 || item1 == nullptr || item2 == nullptr )
+        return;
+
+    if ( item1 == this )
+    {
+        std::swap( item1, item2 );
+        std::swap( edge1, edge2 );
+    }
+
+    if ( item2 == this )
+        item2 = nullptr;
+
+    for ( auto item : { item1, item2 } )
+    {
+        if ( item == nullptr )
+            continue;
+
+        if ( item->parent() == nullptr )
+            item->setParent( this );
+
+        if ( item->parentItem() != this )
+            item->setParentItem( this );
+
+        auto& itemHints = m_data->itemHints;
+        if ( itemHints.find( item ) == itemHints.end() )
+            itemHints[ item ] = qskItemHints( item );
+    }
+
+    Anchor anchor;
+    anchor.item1 = item1;
+    anchor.edge1 = edge1;
+    anchor.item2 = item2;
+    anchor.edge2 = edge2;
+
+    m_data->anchors += anchor;
+
+    // new anchors change the structure of the tableau
+    m_data->resetSolvers();
+
+    resetImplicitSize();
+    polish();
+}
+
+void QskAnchorBox::removeAnchors( const QQuickItem* item )
+{
+    auto& anchors = m_data->anchors;
+
+    const auto count = anchors.count();
+
+    for ( int i = anchors.count() - 1; i >= 0; i-- )
+    {
+        const auto& anchor = anchors[i];
+        if ( anchor.item1 == item || anchor.item2 == item )
+            anchors.removeAt( i );
+    }
+
+    if ( anchors.count() != count )
+    {
+        m_data->itemHints.erase( const_cast< QQuickItem* >( item ) );
+        m_data->resetSolvers();
+
+        resetImplicitSize();
+        polish();
+    }
+}
+
+void QskAnchorBox::clearAnchors()
+{
+    if ( !m_data->anchors.isEmpty() )
+    {
+        m_data->anchors.clear();
+        m_data->itemHints.clear();
+        m_data->resetSolvers();
+
+        resetImplicitSize();
+        polish();
+    }
+}
+
+int QskAnchorBox::anchorCount() const
+{
+    return m_data->anchors.count();
+}
+
+void QskAnchorBox::invalidate()
+{
+    updateItemHints();
+}
+
+void QskAnchorBox::updateItemHints()
+{
+    bool isModified = false;
+
+    for ( auto it = m_data->itemHints.begin(); it != m_data->itemHints.end(); ++it )
+    {
+        const auto item = it->first;
+        const auto hints = qskItemHints( item );
+
+        if ( hints != it->second )
+        {
+            it->second = hints;
+
+            if ( m_data->hintsSolver )
+                m_data->hintsSolver->setHints( item, hints );
+
+            if ( m_data->layoutSolver )
+                m_data->layoutSolver->setHints( item, hints );
+
+            isModified = true;
+        }
+    }
+
+    if ( isModified )
+    {
+        m_data->hasValidHints = false;
+        m_data->layoutSize = QSizeF();
+
+        resetImplicitSize();
+        polish();
+    }
+}
+
+bool QskAnchorBox::event( QEvent* event )
+{
+    if ( event->type() == QEvent::LayoutRequest )
+    {
+        // one of the children has new size hints
+        updateItemHints();
+    }
+
+    return Inherited::event( event );
+}
+
+void QskAnchorBox::itemChange( ItemChange change, const ItemChangeData& value )
+{
+    Inherited::itemChange( change, value );
+
+    if ( change == QQuickItem::ItemChildRemovedChange )
+        removeAnchors( value.item );
+}
+
+void QskAnchorBox::geometryChangeEvent( QskGeometryChangeEvent* event )
+{
+    Inherited::geometryChangeEvent( event );
+
+    if ( event->isResized() )
+        polish();
+}
+
+void QskAnchorBox::updateLayout()
+{
+    if ( maybeUnresized() )
+        return;
+
+    const auto rect = layoutRect();
+
+    auto& solver = m_data->layoutSolver;
+
+    if ( solver == nullptr )
+    {
+        if ( m_data->itemHints.empty() )
+            return;
+
+        updateItemHints();
+
+        solver.reset( new LayoutSolver( true, m_data->anchors, m_data->itemHints ) );
+        solver->setEditable( true );
+
+        m_data->layoutSize = QSizeF();
+    }
+
+    if ( rect.size() != m_data->layoutSize )
+    {
+        solver->resolvedSize( rect.size() );
+        m_data->layoutSize = rect.size();
+    }
+
+    const auto& geometries = solver->geometries();
+    for ( auto it = geometries.begin(); it != geometries.end(); ++it )
+    {
+        auto r = it->second.rect();
+        r.translate( rect.left(), rect.top() );
+
+        qskSetItemGeometry( it->first, r );
+    }
+}
+
+QSizeF QskAnchorBox::layoutSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    if ( !m_data->hasValidHints )
+        updateBoxHints();
+
+    if ( constraint.width() >= 0.0 || constraint.height() >= 0.0 )
+    {
+        const auto& solver = m_data->hintsSolver;
+        if ( solver == nullptr )
+            return QSizeF();
+
+        // not cached, as constrained hints are rarely requested
+
+        if ( constraint.width() >= 0.0 )
+        {
+            const auto size = solver->resolvedSize(
+                which, Qt::Horizontal, constraint.width() );
+
+            return QSizeF( -1.0, size.height() );
+        }
+        else
+        {
+            const auto size = solver->resolvedSize(
+                which, Qt::Vertical, constraint.height() );
+
+            return QSizeF( size.width(), -1.0 );
+        }
+    }
+
+    return m_data->boxHints[ which ];
+}
+
+void QskAnchorBox::updateBoxHints() const
+{
+    /*
+        Only the solver and the box hints are updated, while the hints
+        of the children are taken from the cache, that is maintained
+        when receiving QEvent::LayoutRequest or in updateLayout().
+        So we never end up in resetImplicitSize() or polish() from
+        inside of a size hint request.
+     */
+
+    auto& boxHints = m_data->boxHints;
+
+    if ( m_data->itemHints.empty() )
+    {
+        boxHints[ Qt::MinimumSize ] = boxHints[ Qt::PreferredSize ] =
+            boxHints[ Qt::MaximumSize ] = QSizeF();
+
+        m_data->hasValidHints = true;
+        return;
+    }
+
+    auto& solver = m_data->hintsSolver;
+
+    if ( solver == nullptr )
+        solver.reset( new LayoutSolver( false, m_data->anchors, m_data->itemHints ) );
+
+    solver->setEditable( false );
+    boxHints[ Qt::PreferredSize ] = solver->resolvedSize();
+
+    solver->setEditable( true );
+    boxHints[ Qt::MinimumSize ] = solver->resolvedSize( QSizeF( 0.0, 0.0 ) );
+    boxHints[ Qt::MaximumSize ] = solver->resolvedSize( QSizeF( qskMaxLength, qskMaxLength ) );
+
+    m_data->hasValidHints = true;
+}
+
+#include "moc_QskAnchorBox.cpp"
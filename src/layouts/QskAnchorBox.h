@@ -3,19 +3,30 @@
  *           SPDX-License-Identifier: BSD-3-Clause
  *****************************************************************************/
 
-#pragma once
+#ifndef QSK_ANCHOR_BOX_H
+#define QSK_ANCHOR_BOX_H
 
 #include "QskControl.h"
 
-class AnchorBox : public QskControl
+/*
+    QskAnchorBox lays out its children according to anchors between
+    their edges/centers and the edges/centers of the box, using
+    a constraint solver ( Cassowary/Kiwi ).
+
+    The solvers are set up once and updated incrementally, when
+    size hints of children change. Resizing the box is done by suggesting
+    new values for the edit variables of the box size, while
+    the size hints of the box are cached.
+ */
+class QSK_EXPORT QskAnchorBox : public QskControl
 {
     Q_OBJECT
 
     using Inherited = QskControl;
 
   public:
-    AnchorBox( QQuickItem* parent = nullptr );
-    ~AnchorBox() override;
+    QskAnchorBox( QQuickItem* parent = nullptr );
+    ~QskAnchorBox() override;
 
     // anchoring to the box
     void addAnchor( QQuickItem*, Qt::AnchorPoint, Qt::AnchorPoint );
@@ -28,16 +39,28 @@ class AnchorBox : public QskControl
     void addAnchors( QQuickItem*, QQuickItem*,
         Qt::Orientations = Qt::Horizontal | Qt::Vertical );
 
+    void removeAnchors( const QQuickItem* );
+    void clearAnchors();
+
+    int anchorCount() const;
+
+  public Q_SLOTS:
+    void invalidate();
+
   protected:
+    bool event( QEvent* ) override;
+    void itemChange( ItemChange, const ItemChangeData& ) override;
     void geometryChangeEvent( QskGeometryChangeEvent* ) override;
-    void updateLayout() override;
 
+    void updateLayout() override;
     QSizeF layoutSizeHint( Qt::SizeHint, const QSizeF& ) const override;
 
   private:
-    void updateHints();
-    void updateGeometries( const QRectF& );
+    void updateItemHints();
+    void updateBoxHints() const;
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
+
+#endif
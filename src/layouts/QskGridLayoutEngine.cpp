@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <functional>
+#include <algorithm>
 
 static inline qreal qskSegmentLength(
     const QskLayoutChain::Segments& s, int start, int end )
@@ -210,6 +211,40 @@ namespace
         // to avoid warnings when assigning size_t to int
         inline int count() const { return static_cast< int >( size() ); }
     };
+
+    /*
+        The effective grids of the elements and the positions
+        of those elements, that occupy more than one cell, sorted by their span.
+        It depends on the structure of the grid only and can be reused
+        for all size requests until an element has been inserted/removed
+        or the dimensions of the grid have changed.
+     */
+    class ElementIndex
+    {
+      public:
+        inline const std::vector< int >& multiCells(
+            Qt::Orientation orientation ) const
+        {
+            return ( orientation == Qt::Horizontal )
+                ? columnMultiCells : rowMultiCells;
+        }
+
+        void clear()
+        {
+            grids.clear();
+            rowMultiCells.clear();
+            columnMultiCells.clear();
+
+            isDirty = true;
+        }
+
+        std::vector< QRect > grids;
+
+        std::vector< int > rowMultiCells;
+        std::vector< int > columnMultiCells;
+
+        bool isDirty = true;
+    };
 }
 
 Element::Element( QQuickItem* item, const QRect& grid )
@@ -354,9 +389,52 @@ class QskGridLayoutEngine::PrivateData
         rowCount = qMax( rowCount, grid.bottom() + 1 );
         columnCount = qMax( columnCount, grid.right() + 1 );
 
+        index.isDirty = true;
+
         return this->elements.count() - 1;
     }
 
+    const ElementIndex& elementIndex() const
+    {
+        if ( index.isDirty )
+        {
+            auto& idx = const_cast< ElementIndex& >( index );
+            idx.clear();
+
+            idx.grids.reserve( elements.size() );
+
+            for ( int i = 0; i < elements.count(); i++ )
+            {
+                const auto grid = effectiveGrid( elements[ i ] );
+                idx.grids.push_back( grid );
+
+                if ( grid.width() > 1 )
+                    idx.columnMultiCells.push_back( i );
+
+                if ( grid.height() > 1 )
+                    idx.rowMultiCells.push_back( i );
+            }
+
+            /*
+                Distributing the hints of the elements with the smaller
+                spans first gives the larger spans a better chance
+                of finding cells with useful metrics. Equal spans are
+                processed in the order of insertion.
+             */
+            const auto& grids = idx.grids;
+
+            std::stable_sort( idx.columnMultiCells.begin(), idx.columnMultiCells.end(),
+                [&grids]( int i1, int i2 ) { return grids[i1].width() < grids[i2].width(); } );
+
+            std::stable_sort( idx.rowMultiCells.begin(), idx.rowMultiCells.end(),
+                [&grids]( int i1, int i2 ) { return grids[i1].height() < grids[i2].height(); } );
+
+            idx.isDirty = false;
+        }
+
+        return index;
+    }
+
     QRect effectiveGrid( const Element& element ) const
     {
         QRect r = element.grid();
@@ -378,6 +456,7 @@ class QskGridLayoutEngine::PrivateData
     }
 
     ElementsVector elements;
+    ElementIndex index;
 
     Settings rowSettings;
     Settings columnSettings;
@@ -415,12 +494,18 @@ bool QskGridLayoutEngine::setStretchFactor(
     if ( orientation == Qt::Horizontal )
     {
         if ( pos >= m_data->columnCount )
+        {
             m_data->columnCount = pos + 1;
+            m_data->index.isDirty = true;
+        }
     }
     else
     {
         if ( pos >= m_data->rowCount )
+        {
             m_data->rowCount = pos + 1;
+            m_data->index.isDirty = true;
+        }
     }
 
     invalidate();
@@ -441,7 +526,10 @@ bool QskGridLayoutEngine::setRowSizeHint(
         return false;
 
     if ( row >= m_data->rowCount )
+    {
         m_data->rowCount = row + 1;
+        m_data->index.isDirty = true;
+    }
 
     invalidate();
     return true;
@@ -460,7 +548,10 @@ bool QskGridLayoutEngine::setColumnSizeHint(
         return false;
 
     if ( column >= m_data->columnCount )
+    {
         m_data->columnCount = column + 1;
+        m_data->index.isDirty = true;
+    }
 
     invalidate();
     return true;
@@ -480,6 +571,7 @@ int QskGridLayoutEngine::insertItem( QQuickItem* item, const QRect& grid )
 
 int QskGridLayoutEngine::insertSpacer( const QSizeF& spacing, const QRect& grid )
 {
+    invalidate();
     return m_data->insertElement( nullptr, spacing, grid );
 }
 
@@ -494,6 +586,8 @@ bool QskGridLayoutEngine::removeAt( int index )
     auto& elements = m_data->elements;
     elements.erase( elements.begin() + index );
 
+    m_data->index.isDirty = true;
+
     // doing a lazy recalculation instead ??
 
     if ( grid.bottom() >= m_data->rowCount
@@ -521,6 +615,7 @@ bool QskGridLayoutEngine::removeAt( int index )
 bool QskGridLayoutEngine::clear()
 {
     m_data->elements.clear();
+    m_data->index.clear();
     m_data->rowSettings.clear();
     m_data->columnSettings.clear();
 
@@ -597,6 +692,8 @@ bool QskGridLayoutEngine::setGridAt( int index, const QRect& grid )
         if ( element->grid() != grid )
         {
             element->setGrid( grid );
+            m_data->index.isDirty = true;
+
             invalidate();
 
             return true;
@@ -628,13 +725,16 @@ void QskGridLayoutEngine::invalidateElementCache()
 
 void QskGridLayoutEngine::layoutItems()
 {
-    for ( const auto& element : m_data->elements )
+    const auto& elements = m_data->elements;
+    const auto& grids = m_data->elementIndex().grids;
+
+    for ( int i = 0; i < elements.count(); i++ )
     {
-        auto item = element.item();
+        auto item = elements[ i ].item();
 
         if ( qskIsAdjustableByLayout( item ) )
         {
-            const auto grid = m_data->effectiveGrid( element );
+            const auto& grid = grids[ i ];
 
             const QskItemLayoutElement layoutElement( item );
 
@@ -653,6 +753,8 @@ void QskGridLayoutEngine::transpose()
     qSwap( m_data->columnSettings, m_data->rowSettings );
     qSwap( m_data->columnCount, m_data->rowCount );
 
+    m_data->index.isDirty = true;
+
     invalidate();
 }
 
@@ -668,37 +770,42 @@ void QskGridLayoutEngine::setupChain( Qt::Orientation orientation,
 {
     /*
         We collect all information from the simple elements first
-        before adding those that occupy more than one cell
+        before adding those that occupy more than one cell. The latter
+        are taken from the index, where they are already sorted by span.
      */
-    QVarLengthArray< const Element* > postponed;
-    postponed.reserve( m_data->elements.count() );
 
-    for ( const auto& element : m_data->elements )
+    const auto& elements = m_data->elements;
+    const auto& index = m_data->elementIndex();
+
+    const bool isHorizontal = ( orientation == Qt::Horizontal );
+
+    for ( int i = 0; i < elements.count(); i++ )
     {
-        if ( element.isIgnored() )
+        const auto& grid = index.grids[ i ];
+
+        const int span = isHorizontal ? grid.width() : grid.height();
+        if ( span > 1 )
             continue;
 
-        auto grid = m_data->effectiveGrid( element );
-        if ( orientation == Qt::Horizontal )
-            grid.setRect( grid.y(), grid.x(), grid.height(), grid.width() );
+        const auto& element = elements[ i ];
+        if ( element.isIgnored() )
+            continue;
 
-        if ( grid.height() == 1 )
+        qreal constraint = -1.0;
+        if ( !constraints.isEmpty() )
         {
-            qreal constraint = -1.0;
-            if ( !constraints.isEmpty() )
+            if ( isHorizontal )
+                constraint = qskSegmentLength( constraints, grid.top(), grid.bottom() );
+            else
                 constraint = qskSegmentLength( constraints, grid.left(), grid.right() );
+        }
 
-            auto cell = element.cell( orientation );
+        auto cell = element.cell( orientation );
 
-            if ( element.item() )
-                cell.metrics = qskItemMetrics( element.item(), orientation, constraint );
+        if ( element.item() )
+            cell.metrics = qskItemMetrics( element.item(), orientation, constraint );
 
-            chain.expandCell( grid.top(), cell );
-        }
-        else
-        {
-            postponed += &element;
-        }
+        chain.expandCell( isHorizontal ? grid.left() : grid.top(), cell );
     }
 
     const auto& settings = m_data->settings( orientation );
@@ -706,18 +813,24 @@ void QskGridLayoutEngine::setupChain( Qt::Orientation orientation,
     for ( const auto& setting : settings.settings() )
         chain.shrinkCell( setting.position, setting.cell() );
 
-    for ( const auto element : postponed )
+    for ( const auto i : index.multiCells( orientation ) )
     {
-        auto grid = m_data->effectiveGrid( *element );
-        if ( orientation == Qt::Horizontal )
+        const auto& element = elements[ i ];
+        if ( element.isIgnored() )
+            continue;
+
+        auto grid = index.grids[ i ];
+        if ( isHorizontal )
             grid.setRect( grid.y(), grid.x(), grid.height(), grid.width() );
 
         qreal constraint = -1.0;
         if ( !constraints.isEmpty() )
             constraint = qskSegmentLength( constraints, grid.left(), grid.right() );
 
-        auto cell = element->cell( orientation );
-        cell.metrics = qskItemMetrics( element->item(), orientation, constraint );
+        auto cell = element.cell( orientation );
+
+        if ( element.item() )
+            cell.metrics = qskItemMetrics( element.item(), orientation, constraint );
 
         chain.expandCells( grid.top(), grid.height(), cell );
     }
@@ -8,11 +8,47 @@
 #include "QskEvent.h"
 #include "QskQuick.h"
 #include "QskFunctions.h"
+#include "QskPlacementPolicy.h"
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
+#include <private/qquickshadereffectsource_p.h>
 QSK_QT_PRIVATE_END
 
+static QQuickItem* qskCreateSnapshot( QskStackBox* box, QQuickItem* page, int index )
+{
+    const auto rect = box->geometryForItemAt( index );
+
+    // the page needs to be visible and laid out to be rendered
+    qskSetItemGeometry( page, rect );
+    page->setVisible( true );
+
+    /*
+        A non live effect source renders the page once into a texture,
+        and hides its nodes from the scene graph.
+     */
+    auto snapshot = new QQuickShaderEffectSource( box );
+    snapshot->setSourceItem( page );
+    snapshot->setLive( false );
+    snapshot->setHideSource( true );
+
+    // not to be added to the layout
+    qskSetPlacementPolicy( snapshot, QskPlacementPolicy::Ignore );
+
+    qskSetItemGeometry( snapshot, rect );
+
+    /*
+        Once the texture has been rendered the page is hidden, so that
+        it is neither polished nor updated during the transition.
+        As the page is referenced by the effect source its nodes are
+        not removed from the scene graph.
+     */
+    QObject::connect( snapshot, &QQuickShaderEffectSource::scheduledUpdateCompleted,
+        page, [ page ] { page->setVisible( false ); } );
+
+    return snapshot;
+}
+
 static Qsk::Direction qskDirection(
     Qt::Orientation orientation, int from, int to, int itemCount )
 {
@@ -153,11 +189,29 @@ QskStackBoxAnimator::QskStackBoxAnimator( QskStackBox* parent )
     : QObject( parent )
     , m_startIndex( -1 )
     , m_endIndex( -1 )
+    , m_snapshotsEnabled( false )
 {
 }
 
 QskStackBoxAnimator::~QskStackBoxAnimator()
 {
+    // the snapshots might have been deleted with the stack box before
+    for ( const auto& snapshot : m_snapshots )
+        delete snapshot.data();
+}
+
+void QskStackBoxAnimator::setSnapshotsEnabled( bool on )
+{
+    if ( m_snapshotsEnabled != on )
+    {
+        stop();
+        m_snapshotsEnabled = on;
+    }
+}
+
+bool QskStackBoxAnimator::snapshotsEnabled() const
+{
+    return m_snapshotsEnabled;
 }
 
 void QskStackBoxAnimator::setStartIndex( int index )
@@ -186,11 +240,49 @@ QskStackBox* QskStackBoxAnimator::stackBox() const
 }
 
 QQuickItem* QskStackBoxAnimator::itemAt( int index ) const
+{
+    if ( auto snapshot = m_snapshots[ ( index == 0 ) ? 0 : 1 ] )
+        return snapshot;
+
+    return pageAt( index );
+}
+
+QQuickItem* QskStackBoxAnimator::pageAt( int index ) const
 {
     return stackBox()->itemAtIndex(
         ( index == 0 ) ? m_startIndex : m_endIndex );
 }
 
+void QskStackBoxAnimator::setup()
+{
+    if ( !m_snapshotsEnabled )
+        return;
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        if ( auto page = pageAt( i ) )
+        {
+            const auto index = ( i == 0 ) ? m_startIndex : m_endIndex;
+            m_snapshots[ i ] = qskCreateSnapshot( stackBox(), page, index );
+        }
+    }
+}
+
+void QskStackBoxAnimator::done()
+{
+    for ( int i = 0; i < 2; i++ )
+    {
+        if ( m_snapshots[ i ] )
+        {
+            delete m_snapshots[ i ];
+            m_snapshots[ i ] = nullptr;
+
+            if ( auto page = pageAt( i ) )
+                page->setVisible( i == 1 );
+        }
+    }
+}
+
 qreal QskStackBoxAnimator::transientIndex() const
 {
     return m_transientIndex;
@@ -267,6 +359,8 @@ Qt::Orientation QskStackBoxAnimator1::orientation() const
 
 void QskStackBoxAnimator1::setup()
 {
+    QskStackBoxAnimator::setup();
+
     auto stackBox = this->stackBox();
 
     m_direction = qskDirection( m_orientation,
@@ -343,6 +437,8 @@ void QskStackBoxAnimator1::done()
 
     if ( !m_hasClip )
         stackBox()->setClip( false );
+
+    QskStackBoxAnimator::done();
 }
 
 bool QskStackBoxAnimator1::eventFilter( QObject* object, QEvent* event )
@@ -405,6 +501,8 @@ bool QskStackBoxAnimator2::isInverted() const
 
 void QskStackBoxAnimator2::setup()
 {
+    QskStackBoxAnimator::setup();
+
     const auto axis = ( m_orientation == Qt::Horizontal )
         ? Qt::YAxis : Qt::XAxis;
 
@@ -468,6 +566,8 @@ void QskStackBoxAnimator2::done()
             item->setVisible( i == 1 );
         }
     }
+
+    QskStackBoxAnimator::done();
 }
 
 QskStackBoxAnimator3::QskStackBoxAnimator3( QskStackBox* parent )
@@ -481,6 +581,8 @@ QskStackBoxAnimator3::~QskStackBoxAnimator3()
 
 void QskStackBoxAnimator3::setup()
 {
+    QskStackBoxAnimator::setup();
+
     if ( auto item = itemAt( 1 ) )
     {
         item->setOpacity( 0.0 );
@@ -507,6 +609,8 @@ void QskStackBoxAnimator3::done()
             item->setVisible( i == 1 ); // not here !!
         }
     }
+
+    QskStackBoxAnimator::done();
 }
 
 QskStackBoxAnimator4::QskStackBoxAnimator4( QskStackBox* parent )
@@ -550,6 +654,8 @@ bool QskStackBoxAnimator4::isInverted() const
 
 void QskStackBoxAnimator4::setup()
 {
+    QskStackBoxAnimator::setup();
+
     if ( auto item = itemAt( 0 ) )
     {
         ( void ) new QuickTransform( item );
@@ -653,6 +759,8 @@ void QskStackBoxAnimator4::done()
             item->setVisible( i == 1 );
         }
     }
+
+    QskStackBoxAnimator::done();
 }
 
 #include "moc_QskStackBoxAnimator.cpp"
@@ -10,6 +10,7 @@
 #include "QskNamespace.h"
 
 #include <qobject.h>
+#include <qpointer.h>
 
 class QskStackBox;
 class QQuickItem;
@@ -31,18 +32,36 @@ class QSK_EXPORT QskStackBoxAnimator : public QObject, public QskAnimator
 
     qreal transientIndex() const;
 
+    /*
+        Instead of the pages the animator can transform snapshots,
+        that are rendered once when starting the transition. The pages
+        themselves are not rendered until the transition has finished.
+     */
+    void setSnapshotsEnabled( bool );
+    bool snapshotsEnabled() const;
+
   protected:
     QskStackBox* stackBox() const;
+
+    // the snapshot of the page, when snapshots are enabled
     QQuickItem* itemAt( int index ) const;
 
+    void setup() override;
+    void done() override;
+
   private:
     void advance( qreal value ) override final;
     virtual void advanceIndex( qreal value ) = 0;
 
+    QQuickItem* pageAt( int index ) const;
+
     int m_startIndex;
     int m_endIndex;
 
     qreal m_transientIndex;
+
+    QPointer< QQuickItem > m_snapshots[ 2 ];
+    bool m_snapshotsEnabled;
 };
 
 class QSK_EXPORT QskStackBoxAnimator1 : public QskStackBoxAnimator
@@ -0,0 +1,698 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskVirtualLinearBox.h"
+#include "QskScrollArea.h"
+#include "QskEvent.h"
+#include "QskQuick.h"
+
+#include <qpointer.h>
+#include <vector>
+
+static inline QskScrollArea* qskEnclosingScrollArea( const QQuickItem* item )
+{
+    for ( auto it = item->parentItem(); it != nullptr; it = it->parentItem() )
+    {
+        if ( auto scrollArea = qobject_cast< QskScrollArea* >( it ) )
+            return scrollArea;
+    }
+
+    return nullptr;
+}
+
+namespace
+{
+    /*
+        The extents ( + spacing ) of all elements stored in a
+        Fenwick tree, so that finding positions and indexes
+        can be done in O(log(n)). Elements, that have not been
+        measured yet, are counted with the estimated extent.
+     */
+    class ExtentIndex
+    {
+      public:
+        void reset( int count )
+        {
+            m_extents.assign( count, -1.0 );
+            rebuild();
+        }
+
+        void resetMeasurements()
+        {
+            std::fill( m_extents.begin(), m_extents.end(), -1.0 );
+            rebuild();
+        }
+
+        bool setEstimated( qreal estimated )
+        {
+            if ( estimated == m_estimated )
+                return false;
+
+            m_estimated = estimated;
+            rebuild();
+
+            return true;
+        }
+
+        inline qreal estimated() const { return m_estimated; }
+
+        bool setSpacing( qreal spacing )
+        {
+            if ( spacing == m_spacing )
+                return false;
+
+            m_spacing = spacing;
+            rebuild();
+
+            return true;
+        }
+
+        inline qreal spacing() const { return m_spacing; }
+
+        inline int count() const
+        {
+            return static_cast< int >( m_extents.size() );
+        }
+
+        inline qreal extentAt( int index ) const
+        {
+            const auto extent = m_extents[ index ];
+            return ( extent >= 0.0 ) ? extent : m_estimated;
+        }
+
+        // a negative extent resets the element to the estimated extent
+        bool setExtentAt( int index, qreal extent )
+        {
+            if ( extent < 0.0 )
+                extent = -1.0;
+
+            if ( extent == m_extents[ index ] )
+                return false;
+
+            const qreal delta = ( ( extent >= 0.0 ) ? extent : m_estimated )
+                - extentAt( index );
+
+            m_extents[ index ] = extent;
+
+            if ( delta == 0.0 )
+                return false;
+
+            for ( int i = index + 1; i <= count(); i += i & -i )
+                m_tree[ i ] += delta;
+
+            return true;
+        }
+
+        qreal positionAt( int index ) const
+        {
+            qreal pos = 0.0;
+
+            for ( int i = qMin( index, count() ); i > 0; i -= i & -i )
+                pos += m_tree[ i ];
+
+            return pos;
+        }
+
+        qreal total() const
+        {
+            const int n = count();
+            return ( n > 0 ) ? positionAt( n ) - m_spacing : 0.0;
+        }
+
+        int indexAt( qreal pos ) const
+        {
+            const int n = count();
+            if ( n <= 0 )
+                return -1;
+
+            int step = 1;
+            while ( 2 * step <= n )
+                step *= 2;
+
+            int index = 0;
+
+            for ( ; step > 0; step /= 2 )
+            {
+                const int next = index + step;
+
+                if ( next <= n && m_tree[ next ] <= pos )
+                {
+                    index = next;
+                    pos -= m_tree[ next ];
+                }
+            }
+
+            return qMin( index, n - 1 );
+        }
+
+      private:
+        void rebuild()
+        {
+            const int n = count();
+            m_tree.assign( n + 1, 0.0 );
+
+            for ( int i = 1; i <= n; i++ )
+            {
+                m_tree[ i ] += extentAt( i - 1 ) + m_spacing;
+
+                const int j = i + ( i & -i );
+                if ( j <= n )
+                    m_tree[ j ] += m_tree[ i ];
+            }
+        }
+
+        qreal m_estimated = 0.0;
+        qreal m_spacing = 0.0;
+
+        std::vector< qreal > m_extents;
+        std::vector< qreal > m_tree;
+    };
+}
+
+class QskVirtualLinearBox::PrivateData
+{
+  public:
+    PrivateData( Qt::Orientation orientation )
+        : orientation( orientation )
+    {
+    }
+
+    inline int lastIndex() const
+    {
+        return firstIndex + items.count() - 1;
+    }
+
+    ExtentIndex extents;
+
+    QPointer< QskScrollArea > scrollArea;
+
+    // the instantiated items for [ firstIndex, lastIndex() ]
+    QVector< QQuickItem* > items;
+    int firstIndex = 0;
+
+    // items, that have been released for being recycled
+    QVector< QQuickItem* > pool;
+
+    qreal cacheExtent = 100.0;
+    qreal crossExtent = -1.0;
+
+    Qt::Orientation orientation;
+};
+
+QskVirtualLinearBox::QskVirtualLinearBox( QQuickItem* parent )
+    : QskVirtualLinearBox( Qt::Vertical, parent )
+{
+}
+
+QskVirtualLinearBox::QskVirtualLinearBox(
+        Qt::Orientation orientation, QQuickItem* parent )
+    : Inherited( false, parent )
+    , m_data( new PrivateData( orientation ) )
+{
+    m_data->extents.setSpacing( 5.0 ); // like QskLinearBox
+
+    if ( orientation == Qt::Vertical )
+        initSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Minimum );
+    else
+        initSizePolicy( QskSizePolicy::Minimum, QskSizePolicy::Preferred );
+}
+
+QskVirtualLinearBox::~QskVirtualLinearBox()
+{
+}
+
+void QskVirtualLinearBox::setOrientation( Qt::Orientation orientation )
+{
+    if ( orientation != m_data->orientation )
+    {
+        m_data->orientation = orientation;
+        setSizePolicy( sizePolicy().transposed() );
+
+        m_data->crossExtent = -1.0;
+        m_data->extents.resetMeasurements();
+
+        resetImplicitSize();
+        polish();
+
+        Q_EMIT orientationChanged();
+    }
+}
+
+Qt::Orientation QskVirtualLinearBox::orientation() const
+{
+    return m_data->orientation;
+}
+
+void QskVirtualLinearBox::setCount( int count )
+{
+    count = qMax( count, 0 );
+
+    if ( count != m_data->extents.count() )
+    {
+        releaseItems();
+        m_data->extents.reset( count );
+
+        resetImplicitSize();
+        polish();
+
+        Q_EMIT countChanged( count );
+    }
+}
+
+int QskVirtualLinearBox::count() const
+{
+    return m_data->extents.count();
+}
+
+void QskVirtualLinearBox::setEstimatedExtent( qreal extent )
+{
+    if ( m_data->extents.setEstimated( qMax( extent, 0.0 ) ) )
+    {
+        resetImplicitSize();
+        polish();
+
+        Q_EMIT estimatedExtentChanged( m_data->extents.estimated() );
+    }
+}
+
+qreal QskVirtualLinearBox::estimatedExtent() const
+{
+    return m_data->extents.estimated();
+}
+
+void QskVirtualLinearBox::setSpacing( qreal spacing )
+{
+    if ( m_data->extents.setSpacing( qMax( spacing, 0.0 ) ) )
+    {
+        resetImplicitSize();
+        polish();
+
+        Q_EMIT spacingChanged();
+    }
+}
+
+void QskVirtualLinearBox::resetSpacing()
+{
+    setSpacing( 5.0 );
+}
+
+qreal QskVirtualLinearBox::spacing() const
+{
+    return m_data->extents.spacing();
+}
+
+void QskVirtualLinearBox::setCacheExtent( qreal extent )
+{
+    extent = qMax( extent, 0.0 );
+
+    if ( extent != m_data->cacheExtent )
+    {
+        m_data->cacheExtent = extent;
+        polish();
+
+        Q_EMIT cacheExtentChanged( extent );
+    }
+}
+
+qreal QskVirtualLinearBox::cacheExtent() const
+{
+    return m_data->cacheExtent;
+}
+
+QQuickItem* QskVirtualLinearBox::itemAtIndex( int index ) const
+{
+    index -= m_data->firstIndex;
+
+    if ( index >= 0 && index < m_data->items.count() )
+        return m_data->items[ index ];
+
+    return nullptr;
+}
+
+int QskVirtualLinearBox::indexOf( const QQuickItem* item ) const
+{
+    if ( item )
+    {
+        const int index = m_data->items.indexOf( const_cast< QQuickItem* >( item ) );
+        if ( index >= 0 )
+            return m_data->firstIndex + index;
+    }
+
+    return -1;
+}
+
+qreal QskVirtualLinearBox::extentAt( int index ) const
+{
+    if ( index < 0 || index >= count() )
+        return -1.0;
+
+    return m_data->extents.extentAt( index );
+}
+
+qreal QskVirtualLinearBox::positionAt( int index ) const
+{
+    if ( index < 0 || index >= count() )
+        return -1.0;
+
+    return m_data->extents.positionAt( index );
+}
+
+int QskVirtualLinearBox::indexAtPosition( qreal pos ) const
+{
+    return m_data->extents.indexAt( qMax( pos, 0.0 ) );
+}
+
+int QskVirtualLinearBox::instantiatedCount() const
+{
+    return m_data->items.count();
+}
+
+int QskVirtualLinearBox::pooledCount() const
+{
+    return m_data->pool.count();
+}
+
+QskScrollArea* QskVirtualLinearBox::scrollArea() const
+{
+    return m_data->scrollArea;
+}
+
+void QskVirtualLinearBox::invalidate()
+{
+    for ( int i = 0; i < m_data->items.count(); i++ )
+        updateItem( m_data->items[ i ], m_data->firstIndex + i );
+
+    m_data->extents.resetMeasurements();
+
+    resetImplicitSize();
+    polish();
+}
+
+void QskVirtualLinearBox::invalidateAt( int index )
+{
+    if ( index < 0 || index >= count() )
+        return;
+
+    if ( auto item = itemAtIndex( index ) )
+        updateItem( item, index );
+
+    if ( m_data->extents.setExtentAt( index, -1.0 ) )
+        resetImplicitSize();
+
+    polish();
+}
+
+bool QskVirtualLinearBox::connectScrollArea()
+{
+    auto scrollArea = qskEnclosingScrollArea( this );
+    if ( scrollArea == m_data->scrollArea )
+        return false;
+
+    if ( m_data->scrollArea )
+        disconnect( m_data->scrollArea.data(), nullptr, this, nullptr );
+
+    m_data->scrollArea = scrollArea;
+
+    if ( scrollArea )
+    {
+        connect( scrollArea, &QskScrollBox::scrollPosChanged,
+            this, &QQuickItem::polish );
+
+        // the viewport might grow without having an effect on our size
+        connect( scrollArea, &QQuickItem::widthChanged,
+            this, &QQuickItem::polish );
+
+        connect( scrollArea, &QQuickItem::heightChanged,
+            this, &QQuickItem::polish );
+    }
+
+    return true;
+}
+
+void QskVirtualLinearBox::releaseItems()
+{
+    for ( auto item : qAsConst( m_data->items ) )
+    {
+        item->setVisible( false );
+        m_data->pool += item;
+    }
+
+    m_data->items.clear();
+    m_data->firstIndex = 0;
+}
+
+void QskVirtualLinearBox::setupItems( int first, int last )
+{
+    auto& items = m_data->items;
+
+    if ( first > last )
+    {
+        releaseItems();
+        return;
+    }
+
+    QVector< QQuickItem* > newItems( last - first + 1, nullptr );
+
+    for ( int i = 0; i < items.count(); i++ )
+    {
+        const int index = m_data->firstIndex + i;
+
+        if ( index >= first && index <= last )
+        {
+            newItems[ index - first ] = items[ i ];
+        }
+        else
+        {
+            items[ i ]->setVisible( false );
+            m_data->pool += items[ i ];
+        }
+    }
+
+    for ( int i = 0; i < newItems.count(); i++ )
+    {
+        auto& item = newItems[ i ];
+        if ( item )
+            continue;
+
+        if ( !m_data->pool.isEmpty() )
+        {
+            item = m_data->pool.takeLast();
+            item->setVisible( true );
+        }
+        else
+        {
+            item = createItem();
+
+            item->setParentItem( this );
+            if ( item->parent() == nullptr )
+                item->setParent( this );
+        }
+
+        updateItem( item, first + i );
+    }
+
+    items = newItems;
+    m_data->firstIndex = first;
+}
+
+bool QskVirtualLinearBox::measureItems()
+{
+    const bool isVertical = ( m_data->orientation == Qt::Vertical );
+    const auto crossExtent = m_data->crossExtent;
+
+    bool isModified = false;
+
+    for ( int i = 0; i < m_data->items.count(); i++ )
+    {
+        const auto item = m_data->items[ i ];
+
+        qreal extent;
+
+        if ( isVertical )
+        {
+            const QSizeF constraint( crossExtent, -1.0 );
+            extent = qskSizeConstraint( item, Qt::PreferredSize, constraint ).height();
+        }
+        else
+        {
+            const QSizeF constraint( -1.0, crossExtent );
+            extent = qskSizeConstraint( item, Qt::PreferredSize, constraint ).width();
+        }
+
+        if ( m_data->extents.setExtentAt( m_data->firstIndex + i, extent ) )
+            isModified = true;
+    }
+
+    return isModified;
+}
+
+void QskVirtualLinearBox::updateLayout()
+{
+    if ( maybeUnresized() )
+        return;
+
+    /*
+        Reparenting one of our ancestors is not notified to us, so
+        the scroll area is resolved again for each layout.
+     */
+    connectScrollArea();
+
+    const auto rect = layoutRect();
+    const bool isVertical = ( m_data->orientation == Qt::Vertical );
+
+    auto& extents = m_data->extents;
+    const auto oldTotal = extents.total();
+
+    const qreal crossExtent = isVertical ? rect.width() : rect.height();
+    if ( crossExtent != m_data->crossExtent )
+    {
+        // all measurements depend on the cross extent
+        m_data->crossExtent = crossExtent;
+        extents.resetMeasurements();
+    }
+
+    QRectF visibleRect = rect;
+
+    if ( auto scrollArea = m_data->scrollArea.data() )
+    {
+        const auto viewRect = mapRectFromItem(
+            scrollArea, scrollArea->viewContentsRect() );
+
+        visibleRect = visibleRect.intersected( viewRect );
+    }
+
+    visibleRect.translate( -rect.topLeft() );
+
+    qreal from, to;
+    if ( isVertical )
+    {
+        from = visibleRect.top();
+        to = visibleRect.bottom();
+    }
+    else
+    {
+        from = visibleRect.left();
+        to = visibleRect.right();
+    }
+
+    if ( extents.count() == 0 || visibleRect.isEmpty() )
+    {
+        /*
+            Not releasing when the visible rectangle is empty,
+            as the box might be hidden only temporarily
+         */
+        if ( extents.count() == 0 )
+            releaseItems();
+    }
+    else
+    {
+        /*
+            Measuring the items changes the positions, what might
+            result in a different set of items being visible. In the
+            worst case we would need count iterations - but usually
+            the estimated extent is a good guess and we are done
+            after 1 or 2 iterations.
+         */
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            const int first = indexAtPosition( from - m_data->cacheExtent );
+            const int last = indexAtPosition( to + m_data->cacheExtent );
+
+            if ( i > 0 && first == m_data->firstIndex && last == m_data->lastIndex() )
+                break;
+
+            setupItems( first, last );
+
+            if ( !measureItems() )
+                break;
+        }
+    }
+
+    for ( int i = 0; i < m_data->items.count(); i++ )
+    {
+        const int index = m_data->firstIndex + i;
+
+        const auto pos = extents.positionAt( index );
+        const auto extent = extents.extentAt( index );
+
+        QRectF r;
+        if ( isVertical )
+            r.setRect( rect.left(), rect.top() + pos, rect.width(), extent );
+        else
+            r.setRect( rect.left() + pos, rect.top(), extent, rect.height() );
+
+        qskSetItemGeometry( m_data->items[ i ], r );
+    }
+
+    if ( extents.total() != oldTotal )
+        resetImplicitSize();
+}
+
+QSizeF QskVirtualLinearBox::layoutSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    Q_UNUSED( constraint )
+
+    if ( which == Qt::MaximumSize )
+        return QSizeF();
+
+    const auto total = m_data->extents.total();
+
+    if ( m_data->orientation == Qt::Vertical )
+        return QSizeF( -1.0, total );
+    else
+        return QSizeF( total, -1.0 );
+}
+
+bool QskVirtualLinearBox::event( QEvent* event )
+{
+    switch ( static_cast< int >( event->type() ) )
+    {
+        case QEvent::LayoutRequest:
+        {
+            // the size hint of one of the instantiated items has changed
+            polish();
+            break;
+        }
+        case QEvent::ContentsRectChange:
+        {
+            polish();
+            break;
+        }
+    }
+
+    return Inherited::event( event );
+}
+
+void QskVirtualLinearBox::itemChange(
+    ItemChange change, const ItemChangeData& value )
+{
+    Inherited::itemChange( change, value );
+
+    switch( change )
+    {
+        case QQuickItem::ItemParentHasChanged:
+        case QQuickItem::ItemSceneChange:
+        {
+            if ( connectScrollArea() )
+                polish();
+
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void QskVirtualLinearBox::geometryChangeEvent( QskGeometryChangeEvent* event )
+{
+    Inherited::geometryChangeEvent( event );
+
+    if ( event->isResized() )
+        polish();
+}
+
+#include "moc_QskVirtualLinearBox.cpp"
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_VIRTUAL_LINEAR_BOX_H
+#define QSK_VIRTUAL_LINEAR_BOX_H
+
+#include "QskBox.h"
+
+class QskScrollArea;
+
+/*
+    QskVirtualLinearBox arranges count items in a single row/column
+    like QskLinearBox, but instantiates only those, that are
+    in or near the viewport of the enclosing QskScrollArea.
+
+    Items are created by createItem() and are recycled, when leaving
+    the viewport. updateItem() assigns the content of a specific index
+    to an item.
+
+    Extents of items, that have not been instantiated so far, are
+    estimated, so that the size hint of the box - and the scroll bars -
+    are approximations, that become more accurate when scrolling.
+ */
+class QSK_EXPORT QskVirtualLinearBox : public QskBox
+{
+    Q_OBJECT
+
+    Q_PROPERTY( Qt::Orientation orientation READ orientation
+        WRITE setOrientation NOTIFY orientationChanged FINAL )
+
+    Q_PROPERTY( int count READ count
+        WRITE setCount NOTIFY countChanged FINAL )
+
+    Q_PROPERTY( qreal estimatedExtent READ estimatedExtent
+        WRITE setEstimatedExtent NOTIFY estimatedExtentChanged FINAL )
+
+    Q_PROPERTY( qreal spacing READ spacing
+        WRITE setSpacing RESET resetSpacing NOTIFY spacingChanged FINAL )
+
+    Q_PROPERTY( qreal cacheExtent READ cacheExtent
+        WRITE setCacheExtent NOTIFY cacheExtentChanged FINAL )
+
+    using Inherited = QskBox;
+
+  public:
+    explicit QskVirtualLinearBox( QQuickItem* parent = nullptr );
+    explicit QskVirtualLinearBox( Qt::Orientation, QQuickItem* parent = nullptr );
+
+    ~QskVirtualLinearBox() override;
+
+    void setOrientation( Qt::Orientation );
+    Qt::Orientation orientation() const;
+
+    void setCount( int );
+    int count() const;
+
+    void setEstimatedExtent( qreal );
+    qreal estimatedExtent() const;
+
+    void setSpacing( qreal );
+    void resetSpacing();
+    qreal spacing() const;
+
+    // extra space before/after the viewport, where items are instantiated
+    void setCacheExtent( qreal );
+    qreal cacheExtent() const;
+
+    // nullptr, when the item for index is not instantiated
+    QQuickItem* itemAtIndex( int index ) const;
+    int indexOf( const QQuickItem* ) const;
+
+    // measured or estimated
+    qreal extentAt( int index ) const;
+    qreal positionAt( int index ) const;
+    int indexAtPosition( qreal ) const;
+
+    int instantiatedCount() const;
+    int pooledCount() const;
+
+    QskScrollArea* scrollArea() const;
+
+  public Q_SLOTS:
+    void invalidate();
+    void invalidateAt( int index );
+
+  Q_SIGNALS:
+    void orientationChanged();
+    void countChanged( int );
+    void estimatedExtentChanged( qreal );
+    void spacingChanged();
+    void cacheExtentChanged( qreal );
+
+  protected:
+    bool event( QEvent* ) override;
+    void itemChange( ItemChange, const ItemChangeData& ) override;
+    void geometryChangeEvent( QskGeometryChangeEvent* ) override;
+
+    void updateLayout() override;
+    QSizeF layoutSizeHint( Qt::SizeHint, const QSizeF& ) const override;
+
+    // the delegate factory
+    virtual QQuickItem* createItem() = 0;
+    virtual void updateItem( QQuickItem*, int index ) = 0;
+
+  private:
+    bool connectScrollArea();
+
+    void setupItems( int first, int last );
+    void releaseItems();
+    bool measureItems();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -3,6 +3,9 @@
 #include "Strength.h"
 #include <memory>
 
+namespace Kiwi
+{
+
 class Expression;
 class Variable;
 class Term;
@@ -115,3 +118,5 @@ extern Constraint operator>=( const Variable&, double );
 extern Constraint operator==( double, const Variable& );
 extern Constraint operator<=( double, const Variable& );
 extern Constraint operator>=( double, const Variable& );
+
+}
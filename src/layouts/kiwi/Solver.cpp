@@ -9,6 +9,9 @@
 #include <vector>
 #include <cstdint>
 
+namespace Kiwi
+{
+
 template< typename T >
 class FlatMap
 {
@@ -1081,3 +1084,5 @@ void Solver::reset()
 {
     m_solver->reset();
 }
+
+}
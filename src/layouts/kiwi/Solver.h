@@ -3,6 +3,9 @@
 #include <qglobal.h>
 #include <memory>
 
+namespace Kiwi
+{
+
 class Variable;
 class Constraint;
 class SimplexSolver;
@@ -33,3 +36,5 @@ class Solver
     Q_DISABLE_COPY( Solver )
     std::unique_ptr< SimplexSolver > m_solver;
 };
+
+}
@@ -2,6 +2,9 @@
 
 #include <algorithm>
 
+namespace Kiwi
+{
+
 namespace Strength
 {
     inline double create( double a, double b, double c, double w = 1.0 )
@@ -24,3 +27,5 @@ namespace Strength
         return std::max( 0.0, std::min( required, value ) );
     }
 }
+
+}
@@ -21,7 +21,9 @@ static inline QskGradient qskEffectiveGradient(
     {
         if ( gradient.type() == QskGradient::Stops )
         {
-            QskGradient g( gradient.stops() );
+            auto g = gradient;
+            g.setSpreadMode( QskGradient::PadSpread );
+            g.setStretchMode( QskGradient::StretchToSize );
             g.setConicDirection( 0.5, 0.5, metrics.startAngle(), 360.0 );
 
             return g;
@@ -39,6 +39,27 @@ namespace
         inline CornerIterator( const QskBoxMetrics& metrics )
             : m_corners( metrics.corners )
         {
+            /*
+                The corner parameters as structure of arrays, so that
+                the compiler is able to vectorize the calculation of
+                the points of all corners. As sx/sy are +/-1 the results
+                are the same as for QskBoxMetrics::Corner::xInner etc.
+             */
+
+            for ( int i = 0; i < 4; i++ )
+            {
+                const auto& c = m_corners[i];
+
+                m_inner.cx[i] = c.centerInnerX;
+                m_inner.cy[i] = c.centerInnerY;
+                m_inner.rx[i] = c.sx * c.radiusInnerX;
+                m_inner.ry[i] = c.sy * c.radiusInnerY;
+
+                m_outer.cx[i] = c.centerX;
+                m_outer.cy[i] = c.centerY;
+                m_outer.rx[i] = c.sx * c.radiusX;
+                m_outer.ry[i] = c.sy * c.radiusY;
+            }
         }
 
         inline void resetSteps( int corner, bool inverted = false )
@@ -54,8 +75,49 @@ namespace
                 c.xOuter( cos() ), c.yOuter( sin() ) );
         }
 
+        // lines of all corners for the current step, indexed by Qt::Corner
+        inline void setBorderLines( QskVertex::Line* lines[ 4 ] ) const
+        {
+            calculatePoints();
+
+            for ( int i = 0; i < 4; i++ )
+                setBorderLineAt( i, lines[i] );
+        }
+
       protected:
+        inline void calculatePoints() const
+        {
+            const qreal cos = this->cos();
+            const qreal sin = this->sin();
+
+            for ( int i = 0; i < 4; i++ )
+            {
+                m_points.x1[i] = m_inner.cx[i] + m_inner.rx[i] * cos;
+                m_points.y1[i] = m_inner.cy[i] + m_inner.ry[i] * sin;
+                m_points.x2[i] = m_outer.cx[i] + m_outer.rx[i] * cos;
+                m_points.y2[i] = m_outer.cy[i] + m_outer.ry[i] * sin;
+            }
+        }
+
+        inline void setBorderLineAt( int corner, QskVertex::Line* line ) const
+        {
+            const auto& p = m_points;
+            line->setLine( p.x1[ corner ], p.y1[ corner ], p.x2[ corner ], p.y2[ corner ] );
+        }
+
         const QskBoxMetrics::Corner* m_corners;
+
+      private:
+        struct
+        {
+            qreal cx[4], cy[4], rx[4], ry[4];
+        } m_inner, m_outer;
+
+      protected:
+        mutable struct
+        {
+            qreal x1[4], y1[4], x2[4], y2[4];
+        } m_points;
     };
 
     class CornerIteratorColor : public CornerIterator
@@ -80,6 +142,17 @@ namespace
                 c.xOuter( cos() ), c.yOuter( sin() ), color( corner ) );
         }
 
+        inline void setBorderLines( QskVertex::ColoredLine* lines[ 4 ] ) const
+        {
+            calculatePoints();
+
+            for ( int i = 0; i < 4; i++ )
+            {
+                const auto& p = m_points;
+                lines[i]->setLine( p.x1[i], p.y1[i], p.x2[i], p.y2[i], color( i ) );
+            }
+        }
+
       private:
         inline QskVertex::Color color( int corner ) const
         {
@@ -192,21 +265,24 @@ static inline QskVertex::ColoredLine* qskAddGradientLines(
     const QLineF& l1, const QLineF& l2, const QskGradient& gradient,
     QskVertex::ColoredLine* lines )
 {
-    const auto stops = gradient.stops();
+    const auto stops = gradient.stopData();
+    const auto count = gradient.stopCount();
 
-    if ( stops.first().position() > 0.0 )
-        ( lines++ )->setLine( l1, stops.first().rgb() );
+    if ( stops[ 0 ].position() > 0.0 )
+        ( lines++ )->setLine( l1, stops[ 0 ].rgb() );
 
-    for( const auto& stop : stops )
+    for( int i = 0; i < count; i++ )
     {
+        const auto& stop = stops[ i ];
+
         const auto p1 = l1.p1() + stop.position() * ( l2.p1() - l1.p1() );
         const auto p2 = l1.p2() + stop.position() * ( l2.p2() - l1.p2() );
 
         ( lines++ )->setLine( p1, p2, stop.rgb() );
     }
 
-    if ( stops.last().position() < 1.0 )
-        ( lines++ )->setLine( l2, stops.last().rgb() );
+    if ( stops[ count - 1 ].position() < 1.0 )
+        ( lines++ )->setLine( l2, stops[ count - 1 ].rgb() );
 
     return lines;
 }
@@ -468,16 +544,17 @@ void QskBoxBasicStroker::setBorderGradientLines(
     }
 
     auto line = lines;
-    const auto& stops = gradient.stops();
+    const auto stops = gradient.stopData();
+    const auto count = gradient.stopCount();
 
-    if ( stops.last().position() < 1.0 )
-        setGradientLineAt( orientation, x1, y1, x2, y2, stops.last(), line++ );
+    if ( stops[ count - 1 ].position() < 1.0 )
+        setGradientLineAt( orientation, x1, y1, x2, y2, stops[ count - 1 ], line++ );
 
-    for( int i = stops.count() - 2; i >= 1; i-- )
+    for( int i = count - 2; i >= 1; i-- )
         setGradientLineAt( orientation, x1, y1, x2, y2, stops[i], line++ );
 
-    if ( stops.first().position() > 0.0 )
-        setGradientLineAt( orientation, x1, y1, x2, y2, stops.first(), line++ );
+    if ( stops[ 0 ].position() > 0.0 )
+        setGradientLineAt( orientation, x1, y1, x2, y2, stops[ 0 ], line++ );
 }
 
 void QskBoxBasicStroker::setBorderLines( QskVertex::Line* lines ) const
@@ -515,12 +592,17 @@ void QskBoxBasicStroker::setBorderLines( QskVertex::Line* lines ) const
 
     if ( m_metrics.isOutsideSymmetric && m_metrics.isInsideRounded )
     {
+        // indexed by Qt::Corner
+        decltype( linesTL ) cornerLines[] = { linesTL, linesTR, linesBL, linesBR };
+
         for ( it.resetSteps( Qt::TopLeftCorner ); !it.isDone(); ++it )
         {
-            it.setBorderLine( Qt::TopLeftCorner, linesTL++ );
-            it.setBorderLine( Qt::TopRightCorner, linesTR-- );
-            it.setBorderLine( Qt::BottomLeftCorner, linesBL-- );
-            it.setBorderLine( Qt::BottomRightCorner, linesBR++ );
+            it.setBorderLines( cornerLines );
+
+            cornerLines[ Qt::TopLeftCorner ]++;
+            cornerLines[ Qt::TopRightCorner ]--;
+            cornerLines[ Qt::BottomLeftCorner ]--;
+            cornerLines[ Qt::BottomRightCorner ]++;
         }
     }
     else
@@ -570,12 +652,17 @@ void QskBoxBasicStroker::setBorderLines( QskVertex::ColoredLine* lines ) const
 
     if ( m_metrics.isOutsideSymmetric && m_metrics.isInsideRounded )
     {
+        // indexed by Qt::Corner
+        decltype( linesTL ) cornerLines[] = { linesTL, linesTR, linesBL, linesBR };
+
         for ( it.resetSteps( Qt::TopLeftCorner ); !it.isDone(); ++it )
         {
-            it.setBorderLine( Qt::TopLeftCorner, linesTL++ );
-            it.setBorderLine( Qt::TopRightCorner, linesTR-- );
-            it.setBorderLine( Qt::BottomLeftCorner, linesBL-- );
-            it.setBorderLine( Qt::BottomRightCorner, linesBR++ );
+            it.setBorderLines( cornerLines );
+
+            cornerLines[ Qt::TopLeftCorner ]++;
+            cornerLines[ Qt::TopRightCorner ]--;
+            cornerLines[ Qt::BottomLeftCorner ]--;
+            cornerLines[ Qt::BottomRightCorner ]++;
         }
     }
     else
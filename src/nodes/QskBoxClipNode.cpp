@@ -9,6 +9,28 @@
 #include "QskBoxShapeMetrics.h"
 #include "QskFunctions.h"
 
+#include <qmath.h>
+#include <qquickwindow.h>
+#include <qsgmaterial.h>
+#include <qsgmaterialshader.h>
+#include <qvector2d.h>
+#include <qvector4d.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickwindow_p.h>
+#include <private/qsgadaptationlayer_p.h>
+#include <private/qsgcontext_p.h>
+QSK_QT_PRIVATE_END
+
+// QSGMaterialRhiShader became QSGMaterialShader in Qt6
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    #include <QSGMaterialRhiShader>
+    using RhiShader = QSGMaterialRhiShader;
+#else
+    using RhiShader = QSGMaterialShader;
+#endif
+
 static inline QskHashValue qskMetricsHash(
     const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border )
 {
@@ -18,6 +40,403 @@ static inline QskHashValue qskMetricsHash(
     return border.hash( hash );
 }
 
+/*
+    The radii of the inner contour in the order being expected by the
+    shader: bottomRight, topRight, bottomLeft, topLeft. The mask can't
+    be done for elliptic corners.
+ */
+static inline bool qskInnerRadii( const QSizeF& size,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border,
+    float radius[ 4 ] )
+{
+    const auto& widths = border.widths();
+
+    const Qt::Corner corners[] = { Qt::BottomRightCorner,
+        Qt::TopRightCorner, Qt::BottomLeftCorner, Qt::TopLeftCorner };
+
+    const qreal bx[] = { widths.right(), widths.right(), widths.left(), widths.left() };
+    const qreal by[] = { widths.bottom(), widths.top(), widths.bottom(), widths.top() };
+
+    const qreal maxRadius = 0.5 * qMin( size.width(), size.height() );
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        const auto r = shape.radius( corners[i] );
+
+        const auto rx = qMax( r.width() - bx[i], 0.0 );
+        const auto ry = qMax( r.height() - by[i], 0.0 );
+
+        if ( !qFuzzyCompare( rx + 1.0, ry + 1.0 ) )
+            return false;
+
+        radius[i] = qMin( rx, maxRadius );
+    }
+
+    return true;
+}
+
+namespace
+{
+    class Vertex
+    {
+      public:
+        float x, y;
+
+        // the coordinates in the layer texture
+        float tx, ty;
+
+        // relative to the center of the box
+        float dx, dy;
+    };
+
+    const QSGGeometry::AttributeSet& qskLayerAttributes()
+    {
+        using A = QSGGeometry::Attribute;
+
+        static const A attributes[] =
+        {
+            A::create( 0, 2, QSGGeometry::FloatType, true ),
+            A::create( 1, 2, QSGGeometry::FloatType ),
+            A::create( 2, 2, QSGGeometry::FloatType )
+        };
+
+        static const QSGGeometry::AttributeSet attributeSet =
+            { 3, sizeof( Vertex ), attributes };
+
+        return attributeSet;
+    }
+
+    class Material final : public QSGMaterial
+    {
+      public:
+        Material();
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        QSGMaterialShader* createShader() const override;
+#else
+        QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+
+        QSGMaterialType* type() const override;
+        int compare( const QSGMaterial* ) const override;
+
+        QSGTexture* texture = nullptr;
+
+        // bottomRight, topRight, bottomLeft, topLeft
+        QVector4D radius;
+
+        // half of the size
+        QVector2D extent;
+    };
+}
+
+namespace
+{
+    class ShaderRhi final : public RhiShader
+    {
+      public:
+        ShaderRhi()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderFileName( VertexStage, root + "boxclip.vert.qsb" );
+            setShaderFileName( FragmentStage, root + "boxclip.frag.qsb" );
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+        {
+            Q_ASSERT( state.uniformData()->size() >= 92 );
+
+            auto data = state.uniformData()->data();
+            bool changed = false;
+
+            const auto matNew = static_cast< const Material* >( newMaterial );
+            const auto matOld = static_cast< const Material* >( oldMaterial );
+
+            if ( state.isMatrixDirty() )
+            {
+                const auto matrix = state.combinedMatrix();
+                memcpy( data + 0, matrix.constData(), 64 );
+
+                changed = true;
+            }
+
+            if ( matOld == nullptr || matNew->radius != matOld->radius
+                || matNew->extent != matOld->extent )
+            {
+                memcpy( data + 64, &matNew->radius, 16 );
+                memcpy( data + 80, &matNew->extent, 8 );
+
+                changed = true;
+            }
+
+            if ( state.isOpacityDirty() )
+            {
+                const float opacity = state.opacity();
+                memcpy( data + 88, &opacity, 4 );
+
+                changed = true;
+            }
+
+            return changed;
+        }
+
+        void updateSampledImage( RenderState& state, int binding,
+            QSGTexture* textures[], QSGMaterial* newMaterial, QSGMaterial* ) override
+        {
+            if ( binding != 1 )
+                return;
+
+            auto texture = static_cast< const Material* >( newMaterial )->texture;
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+            texture->updateRhiTexture( state.rhi(), state.resourceUpdateBatch() );
+#else
+            texture->commitTextureOperations( state.rhi(), state.resourceUpdateBatch() );
+#endif
+
+            textures[0] = texture;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    // the old type of shader - specific for OpenGL
+
+    class ShaderGL final : public QSGMaterialShader
+    {
+      public:
+        ShaderGL()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderSourceFile( QOpenGLShader::Vertex, root + "boxclip.vert" );
+            setShaderSourceFile( QOpenGLShader::Fragment, root + "boxclip.frag" );
+        }
+
+        char const* const* attributeNames() const override
+        {
+            static char const* const names[] =
+                { "in_vertex", "in_texCoord", "in_coord", nullptr };
+
+            return names;
+        }
+
+        void initialize() override
+        {
+            QSGMaterialShader::initialize();
+
+            auto p = program();
+
+            m_matrixId = p->uniformLocation( "matrix" );
+            m_radiusId = p->uniformLocation( "radius" );
+            m_extentId = p->uniformLocation( "extent" );
+            m_opacityId = p->uniformLocation( "opacity" );
+        }
+
+        void updateState( const QSGMaterialShader::RenderState& state,
+            QSGMaterial* newMaterial, QSGMaterial* ) override
+        {
+            auto p = program();
+            auto material = static_cast< const Material* >( newMaterial );
+
+            if ( state.isMatrixDirty() )
+                p->setUniformValue( m_matrixId, state.combinedMatrix() );
+
+            if ( state.isOpacityDirty() )
+                p->setUniformValue( m_opacityId, state.opacity() );
+
+            p->setUniformValue( m_radiusId, material->radius );
+            p->setUniformValue( m_extentId, material->extent );
+
+            material->texture->bind();
+        }
+
+      private:
+        int m_matrixId = -1;
+        int m_radiusId = -1;
+        int m_extentId = -1;
+        int m_opacityId = -1;
+    };
+}
+
+#endif
+
+Material::Material()
+{
+    setFlag( QSGMaterial::Blending, true );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    setFlag( QSGMaterial::SupportsRhiShader, true );
+#endif
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+QSGMaterialShader* Material::createShader() const
+{
+    if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+        return new ShaderGL();
+
+    return new ShaderRhi();
+}
+
+#else
+
+QSGMaterialShader* Material::createShader( QSGRendererInterface::RenderMode ) const
+{
+    return new ShaderRhi();
+}
+
+#endif
+
+QSGMaterialType* Material::type() const
+{
+    static QSGMaterialType staticType;
+    return &staticType;
+}
+
+int Material::compare( const QSGMaterial* other ) const
+{
+    const auto material = static_cast< const Material* >( other );
+
+    if ( ( material->texture == texture )
+        && ( material->radius == radius ) && ( material->extent == extent ) )
+    {
+        return 0;
+    }
+
+    return QSGMaterial::compare( other );
+}
+
+/*
+    The nodes to be clipped are below an invisible opacity node, so that
+    they are ignored by the renderer of the window. The layer finds the
+    root node and renders the nodes from there - the same way it is done
+    for QQuickItem::layer.
+ */
+class QskBoxClipNode::LayerNode final : public QSGGeometryNode
+{
+  public:
+    LayerNode( QQuickWindow* window )
+        : m_geometry( qskLayerAttributes(), 4 )
+    {
+        m_geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+
+        setGeometry( &m_geometry );
+        setMaterial( &m_material );
+
+        // the texture has to be updated before rendering the scene
+        setFlag( QSGNode::UsePreprocess, true );
+
+        m_rootNode = new QSGRootNode();
+
+        auto opacityNode = new QSGOpacityNode();
+        opacityNode->setOpacity( 0.0 );
+        opacityNode->appendChildNode( m_rootNode );
+
+        appendChildNode( opacityNode );
+
+        auto context = QQuickWindowPrivate::get( window )->context;
+
+        m_layer = context->sceneGraphContext()->createLayer( context );
+        m_layer->setItem( m_rootNode );
+        m_layer->setLive( true );
+        m_layer->setRecursive( false );
+        m_layer->setHasMipmaps( false );
+        m_layer->setFiltering( QSGTexture::Linear );
+
+        // like QQuickShaderEffectSource, so that the texture is not upside down
+        m_layer->setMirrorVertical( true );
+
+        m_devicePixelRatio = window->effectiveDevicePixelRatio();
+        m_layer->setDevicePixelRatio( m_devicePixelRatio );
+
+        m_material.texture = m_layer;
+    }
+
+    ~LayerNode() override
+    {
+        // the renderer of the layer refers to the root node
+        delete m_layer;
+    }
+
+    inline QSGNode* rootNode() const
+    {
+        return m_rootNode;
+    }
+
+    void setSource( QSGNode* itemNode )
+    {
+        m_layer->setItem( itemNode ? itemNode : m_rootNode );
+    }
+
+    void setBox( const QRectF& rect, const float radius[ 4 ] )
+    {
+        m_layer->setRect( rect );
+        m_layer->setSize( QSize( qCeil( rect.width() * m_devicePixelRatio ),
+            qCeil( rect.height() * m_devicePixelRatio ) ) );
+
+        const float x1 = rect.left();
+        const float y1 = rect.top();
+        const float x2 = rect.right();
+        const float y2 = rect.bottom();
+
+        const float cx = rect.center().x();
+        const float cy = rect.center().y();
+
+        const float xy[4][4] =
+        {
+            { x1, y1, 0.0f, 0.0f }, { x2, y1, 1.0f, 0.0f },
+            { x1, y2, 0.0f, 1.0f }, { x2, y2, 1.0f, 1.0f }
+        };
+
+        auto vertices = static_cast< Vertex* >( m_geometry.vertexData() );
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            auto& v = vertices[i];
+
+            v.x = xy[i][0];
+            v.y = xy[i][1];
+            v.tx = xy[i][2];
+            v.ty = xy[i][3];
+            v.dx = v.x - cx;
+            v.dy = v.y - cy;
+        }
+
+        m_material.radius = QVector4D( radius[0], radius[1], radius[2], radius[3] );
+        m_material.extent = QVector2D( 0.5 * rect.width(), 0.5 * rect.height() );
+
+        markDirty( QSGNode::DirtyGeometry | QSGNode::DirtyMaterial );
+    }
+
+    void preprocess() override
+    {
+        /*
+            Nodes, that have been appended to the clip node directly, would
+            not be clipped. They have to be inserted to contentsNode().
+         */
+        Q_ASSERT( parent() == nullptr || parent()->childCount() == 1 );
+
+        // the layer is live and renders only when its nodes have changed
+        m_layer->updateTexture();
+    }
+
+  private:
+    QSGGeometry m_geometry;
+    Material m_material;
+
+    QSGLayer* m_layer = nullptr;
+    QSGRootNode* m_rootNode = nullptr;
+
+    qreal m_devicePixelRatio = 1.0;
+};
+
 QskBoxClipNode::QskBoxClipNode()
     : m_hash( 0 )
     , m_geometry( QSGGeometry::defaultAttributes_Point2D(), 0 )
@@ -29,6 +448,53 @@ QskBoxClipNode::~QskBoxClipNode()
 {
 }
 
+void QskBoxClipNode::setLayered( QQuickWindow* window, bool on )
+{
+    on = on && ( window != nullptr );
+
+    if ( on == isLayered() )
+        return;
+
+    if ( on )
+    {
+        m_layerNode = new LayerNode( window );
+
+        reparentChildNodesTo( m_layerNode->rootNode() );
+        appendChildNode( m_layerNode );
+    }
+    else
+    {
+        removeChildNode( m_layerNode );
+        m_layerNode->rootNode()->reparentChildNodesTo( this );
+
+        delete m_layerNode;
+        m_layerNode = nullptr;
+    }
+
+    // enforcing an update in the next setBox
+    m_hash = 0;
+    m_rect = QRectF();
+}
+
+bool QskBoxClipNode::isLayered() const
+{
+    return m_layerNode != nullptr;
+}
+
+QSGNode* QskBoxClipNode::contentsNode()
+{
+    if ( m_layerNode )
+        return m_layerNode->rootNode();
+
+    return this;
+}
+
+void QskBoxClipNode::setLayerSource( QSGNode* itemNode )
+{
+    if ( m_layerNode )
+        m_layerNode->setSource( itemNode );
+}
+
 void QskBoxClipNode::setBox( const QRectF& rect,
     const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border )
 {
@@ -76,5 +542,43 @@ void QskBoxClipNode::setBox( const QRectF& rect,
      */
     setClipRect( qskValidOrEmptyInnerRect( rect, border.widths() ) );
 
+    if ( m_layerNode )
+        updateLayer( shape, border );
+
     markDirty( QSGNode::DirtyGeometry );
 }
+
+void QskBoxClipNode::updateLayer(
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border )
+{
+    const auto rect = clipRect();
+
+    float radius[ 4 ];
+
+    if ( qskInnerRadii( rect.size(), shape, border, radius ) )
+    {
+        /*
+            The rounded corners are done by the mask and the bounding
+            rectangle is good enough for clipping the quad - what can be
+            done by scissoring. To compensate the rounding of the scissor
+            rectangle we add a pixel.
+
+            The geometry is kept for situations, where the renderer has
+            to fall back to stencil clipping ( f.e. rotations ) and for
+            QskScrollArea, that shares it for clipping its items.
+         */
+        setIsRectangular( true );
+        setClipRect( rect.adjusted( -1.0, -1.0, 1.0, 1.0 ) );
+    }
+    else
+    {
+        /*
+            Elliptic corners: the quad is clipped by the stencil buffer,
+            but the nodes in the layer are still batched.
+         */
+        for ( auto& r : radius )
+            r = 0.0f;
+    }
+
+    m_layerNode->setBox( rect, radius );
+}
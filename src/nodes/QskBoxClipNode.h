@@ -11,6 +11,7 @@
 
 class QskBoxShapeMetrics;
 class QskBoxBorderMetrics;
+class QQuickWindow;
 
 class QSK_EXPORT QskBoxClipNode : public QSGClipNode
 {
@@ -21,11 +22,47 @@ class QSK_EXPORT QskBoxClipNode : public QSGClipNode
     void setBox( const QRectF&,
         const QskBoxShapeMetrics&, const QskBoxBorderMetrics& );
 
+    /*
+        Non rectangular clips are done with the stencil buffer, what
+        breaks the batching of all nodes below the clip node.
+
+        In layered mode the nodes to be clipped are rendered into an
+        offscreen texture instead, that is composited by a quad masked
+        with a signed distance function for the rounded corners.
+
+        As the window is needed for creating the offscreen texture
+        the layered mode can't be enabled without it.
+     */
+    void setLayered( QQuickWindow*, bool on );
+    bool isLayered() const;
+
+    /*
+        The parent for the nodes, that have to be clipped: the clip
+        node itself, unless being layered. In layered mode the layer
+        has to be the only child of the clip node, so nodes must never
+        be appended to the clip node directly.
+     */
+    QSGNode* contentsNode();
+
+    /*
+        In layered mode the nodes below contentsNode() are rendered.
+        Alternatively the layer renders the subtree of an item, that
+        is hidden from the window - like it is done by QQuickShaderEffectSource.
+        This is how QskScrollArea clips its scrolled item.
+     */
+    void setLayerSource( QSGNode* itemNode );
+
   private:
+    class LayerNode;
+
+    void updateLayer( const QskBoxShapeMetrics&, const QskBoxBorderMetrics& );
+
     QskHashValue m_hash;
     QRectF m_rect;
 
     QSGGeometry m_geometry;
+
+    LayerNode* m_layerNode = nullptr;
 };
 
 #endif
@@ -120,11 +120,12 @@ namespace QskBox
         {
         }
 
-        inline GradientIterator( const QskGradientStops& stops )
-            : m_stops( stops )
-            , m_color1( stops.first().rgb() )
+        inline GradientIterator( const QskGradient& gradient )
+            : m_stops( gradient.stopData() )
+            , m_count( gradient.stopCount() )
+            , m_color1( m_stops[ 0 ].rgb() )
             , m_color2( m_color1 )
-            , m_pos1( stops.first().position() )
+            , m_pos1( m_stops[ 0 ].position() )
             , m_pos2( m_pos1 )
             , m_index( 0 )
         {
@@ -144,13 +145,14 @@ namespace QskBox
             m_color2 = color2;
         }
 
-        inline void reset( const QskGradientStops& stops )
+        inline void reset( const QskGradient& gradient )
         {
-            m_stops = stops;
+            m_stops = gradient.stopData();
+            m_count = gradient.stopCount();
 
             m_index = 0;
-            m_color1 = m_color2 = stops.first().rgb();
-            m_pos1 = m_pos2 = stops.first().position();
+            m_color1 = m_color2 = m_stops[ 0 ].rgb();
+            m_pos1 = m_pos2 = m_stops[ 0 ].position();
         }
 
         inline qreal position() const
@@ -190,7 +192,7 @@ namespace QskBox
             m_pos1 = m_pos2;
             m_color1 = m_color2;
 
-            if ( ++m_index < m_stops.size() )
+            if ( ++m_index < m_count )
             {
                 const auto& s = m_stops[ m_index ];
 
@@ -206,11 +208,13 @@ namespace QskBox
             if ( m_index < 0 )
                 return true;
 
-            return m_index >= m_stops.size();
+            return m_index >= m_count;
         }
 
       private:
-        QskGradientStops m_stops;
+        // the stops of a gradient, that lives longer than the iterator
+        const QskGradientStop* m_stops = nullptr;
+        int m_count = 0;
 
         QskVertex::Color m_color1, m_color2;
 
@@ -52,7 +52,7 @@ namespace
             Value v1, v2;
             ArcIterator arcIt;
 
-            m_gradientIterator.reset( gradient.stops() );
+            m_gradientIterator.reset( gradient );
 
             m_c1 = &corners[ Qt::TopLeftCorner ];
             m_c2 = &corners[ m_isVertical ? Qt::TopRightCorner : Qt::BottomLeftCorner ];
@@ -527,7 +527,7 @@ namespace
         int setLines( const QskGradient& gradient, ColoredLine* lines )
         {
             ContourIterator it( m_metrics, gradient.linearDirection() );
-            QskBox::GradientIterator gradientIt( gradient.stops() );
+            QskBox::GradientIterator gradientIt( gradient );
 
             ColoredLine* l = lines;
 
@@ -583,7 +583,7 @@ namespace
             const qreal y1 = m_metrics.innerRect.top();
             const qreal y2 = m_metrics.innerRect.bottom();
 
-            QskBox::GradientIterator it( gradient.stops() );
+            QskBox::GradientIterator it( gradient );
             ColoredLine* l = lines;
 
             const auto dir = gradient.linearDirection();
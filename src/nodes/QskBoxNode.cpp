@@ -88,6 +88,8 @@ void QskBoxNode::updateNode( const QRectF& rect,
     if ( QskBox::isGradientSupported( shape, gradient ) )
     {
         rectNode = qskNode< QskBoxRectangleNode >( this, BoxRole );
+        rectNode->setDistanceFieldEnabled( m_distanceField );
+        rectNode->setColorPolicy( m_colorPolicy );
         rectNode->updateNode( rect, shape, borderMetrics, borderColors, gradient );
     }
     else
@@ -95,6 +97,8 @@ void QskBoxNode::updateNode( const QRectF& rect,
         if ( !borderMetrics.isNull() && borderColors.isVisible() )
         {
             rectNode = qskNode< QskBoxRectangleNode >( this, BoxRole );
+            rectNode->setDistanceFieldEnabled( m_distanceField );
+            rectNode->setColorPolicy( m_colorPolicy );
             rectNode->updateNode( rect, shape, borderMetrics, borderColors, QskGradient() );
         }
 
@@ -7,6 +7,8 @@
 #define QSK_BOX_NODE_H
 
 #include "QskGlobal.h"
+#include "QskBoxRectangleNode.h"
+
 #include <qsgnode.h>
 
 class QskShadowMetrics;
@@ -27,6 +29,38 @@ class QSK_EXPORT QskBoxNode : public QSGNode
         const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
         const QskBoxBorderColors&, const QskGradient&,
         const QskShadowMetrics&, const QColor& shadowColor );
+
+    // see QskBoxRectangleNode::setDistanceFieldEnabled
+    void setDistanceFieldEnabled( bool );
+    bool isDistanceFieldEnabled() const;
+
+    // see QskBoxRectangleNode::setColorPolicy
+    void setColorPolicy( QskBoxRectangleNode::ColorPolicy );
+    QskBoxRectangleNode::ColorPolicy colorPolicy() const;
+
+  private:
+    bool m_distanceField = false;
+    QskBoxRectangleNode::ColorPolicy m_colorPolicy = QskBoxRectangleNode::VertexColors;
 };
 
+inline void QskBoxNode::setDistanceFieldEnabled( bool on )
+{
+    m_distanceField = on;
+}
+
+inline bool QskBoxNode::isDistanceFieldEnabled() const
+{
+    return m_distanceField;
+}
+
+inline void QskBoxNode::setColorPolicy( QskBoxRectangleNode::ColorPolicy policy )
+{
+    m_colorPolicy = policy;
+}
+
+inline QskBoxRectangleNode::ColorPolicy QskBoxNode::colorPolicy() const
+{
+    return m_colorPolicy;
+}
+
 #endif
@@ -7,6 +7,7 @@
 #include "QskBoxBorderColors.h"
 #include "QskBoxBorderMetrics.h"
 #include "QskBoxRenderer.h"
+#include "QskBoxSdfMaterial.h"
 #include "QskBoxShapeMetrics.h"
 #include "QskGradient.h"
 #include "QskGradientDirection.h"
@@ -68,6 +69,20 @@ class QskBoxRectangleNodePrivate final : public QSGGeometryNodePrivate
     QRectF rect;
 
     QSGGeometry geometry;
+
+    /*
+        The colors of the vertices, when the geometry has been
+        created from a monochrome fill and border.
+     */
+    QskVertex::Color fillColor;
+    QskVertex::Color borderColor;
+
+    bool isMonochrome = false;
+    bool hasFill = false;
+    bool hasBorder = false;
+
+    bool distanceField = false;
+    QskBoxRectangleNode::ColorPolicy colorPolicy = QskBoxRectangleNode::VertexColors;
 };
 
 QskBoxRectangleNode::QskBoxRectangleNode()
@@ -81,8 +96,49 @@ QskBoxRectangleNode::QskBoxRectangleNode()
 
 QskBoxRectangleNode::~QskBoxRectangleNode()
 {
-    if ( material() != qskMaterialColorVertex )
-        delete material();
+    const auto material = this->material();
+
+    if ( material != qskMaterialColorVertex
+        && material != QskBoxSdfMaterial::instance() )
+    {
+        delete material;
+    }
+}
+
+void QskBoxRectangleNode::setDistanceFieldEnabled( bool on )
+{
+    Q_D( QskBoxRectangleNode );
+
+    if ( on != d->distanceField )
+    {
+        d->distanceField = on;
+
+        // enforcing an update
+        d->metricsHash = d->colorsHash = 0;
+    }
+}
+
+bool QskBoxRectangleNode::isDistanceFieldEnabled() const
+{
+    return d_func()->distanceField;
+}
+
+void QskBoxRectangleNode::setColorPolicy( ColorPolicy policy )
+{
+    Q_D( QskBoxRectangleNode );
+
+    if ( policy != d->colorPolicy )
+    {
+        d->colorPolicy = policy;
+
+        // enforcing an update
+        d->metricsHash = d->colorsHash = 0;
+    }
+}
+
+QskBoxRectangleNode::ColorPolicy QskBoxRectangleNode::colorPolicy() const
+{
+    return d_func()->colorPolicy;
 }
 
 void QskBoxRectangleNode::updateNode(
@@ -114,22 +170,22 @@ void QskBoxRectangleNode::updateNode( const QRectF& rect,
     const auto metricsHash = qskMetricsHash( shape, borderMetrics );
     const auto colorsHash = qskColorsHash( borderColors, fillGradient );
 
-    if ( ( metricsHash == d->metricsHash ) &&
-        ( colorsHash == d->colorsHash ) && ( rect == d->rect ) )
-    {
+    const bool isGeometryValid =
+        ( metricsHash == d->metricsHash ) && ( rect == d->rect );
+
+    if ( isGeometryValid && ( colorsHash == d->colorsHash ) )
         return;
-    }
 
     d->metricsHash = metricsHash;
     d->colorsHash = colorsHash;
     d->rect = rect;
 
-    markDirty( QSGNode::DirtyMaterial );
-    markDirty( QSGNode::DirtyGeometry );
-
     if ( rect.isEmpty() )
     {
+        d->isMonochrome = false;
         d->geometry.allocate( 0 );
+
+        markDirty( QSGNode::DirtyGeometry );
         return;
     }
 
@@ -148,7 +204,10 @@ void QskBoxRectangleNode::updateNode( const QRectF& rect,
 
     if ( !hasBorder && !hasFill )
     {
+        d->isMonochrome = false;
         d->geometry.allocate( 0 );
+
+        markDirty( QSGNode::DirtyGeometry );
         return;
     }
 
@@ -167,40 +226,50 @@ void QskBoxRectangleNode::updateNode( const QRectF& rect,
         }
     }
 
-#if 0
-    /*
-        Always using the same material result in a better batching
-        but wastes some memory. when we have a solid color.
-        Maybe its worth to introduce a flag to control the behaviour,
-        but for the moment we go with performance.
-     */
+    if ( isGeometryValid )
+    {
+        // only the colors have changed
+        if ( updateColors( hasFill, hasBorder, borderColors, fillGradient ) )
+            return;
+    }
 
-    bool maybeFlat = true;
+    markDirty( QSGNode::DirtyMaterial );
+    markDirty( QSGNode::DirtyGeometry );
+
+    d->isMonochrome = false;
 
-    if ( maybeFlat )
+    if ( d->distanceField )
     {
-        if ( ( hasFill && hasBorder ) ||
-            ( hasFill && !isFillMonochrome ) ||
-            ( hasBorder && !isBorderMonochrome ) )
+        if ( updateDistanceField( shape, borderMetrics, borderColors,
+            hasFill ? fillGradient : QskGradient() ) )
         {
-            maybeFlat = false;
+            return;
         }
     }
-#else
+
+    const bool isMonochrome = isFillMonochrome && isBorderMonochrome;
+
     bool maybeFlat = false;
-#endif
+
+    if ( d->colorPolicy == FlatColors && isMonochrome )
+    {
+        // all is done with one color, when having a fill or a border only
+        maybeFlat = !( hasFill && hasBorder );
+    }
 
     if ( !maybeFlat )
     {
-        setMonochrome( false );
+        setMaterialType( VertexColor );
 
         QskBox::renderBox( d->rect, shape, borderMetrics,
             borderColors, fillGradient, *geometry() );
+
+        d->isMonochrome = isMonochrome;
     }
     else
     {
         // all is done with one color
-        setMonochrome( true );
+        setMaterialType( FlatColor );
 
         auto* flatMaterial = static_cast< QSGFlatColorMaterial* >( material() );
 
@@ -216,33 +285,156 @@ void QskBoxRectangleNode::updateNode( const QRectF& rect,
             QskBox::renderBorderGeometry(
                 d->rect, shape, borderMetrics, *geometry() );
         }
+
+        d->isMonochrome = true;
+    }
+
+    if ( d->isMonochrome )
+    {
+        d->hasFill = hasFill;
+        d->hasBorder = hasBorder;
+
+        d->fillColor = hasFill ? fillGradient.rgbStart() : QskVertex::Color();
+        d->borderColor = hasBorder ? borderColors.left().rgbStart() : QskVertex::Color();
+    }
+}
+
+bool QskBoxRectangleNode::updateDistanceField( const QskBoxShapeMetrics& shape,
+    const QskBoxBorderMetrics& borderMetrics, const QskBoxBorderColors& borderColors,
+    const QskGradient& fillGradient )
+{
+    Q_D( QskBoxRectangleNode );
+
+    QskBoxSdfMaterial::Vertex vertices[ 4 ];
+
+    if ( !QskBoxSdfMaterial::setBox( vertices, d->rect,
+        shape, borderMetrics, borderColors, fillGradient ) )
+    {
+        return false;
+    }
+
+    setMaterialType( DistanceField );
+
+    d->geometry.allocate( 4 );
+    d->geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+
+    memcpy( d->geometry.vertexData(), vertices, sizeof( vertices ) );
+
+    return true;
+}
+
+bool QskBoxRectangleNode::updateColors( bool hasFill, bool hasBorder,
+    const QskBoxBorderColors& borderColors, const QskGradient& fillGradient )
+{
+    Q_D( QskBoxRectangleNode );
+
+    if ( !d->isMonochrome || ( hasFill != d->hasFill ) || ( hasBorder != d->hasBorder ) )
+        return false;
+
+    if ( ( hasFill && !fillGradient.isMonochrome() )
+        || ( hasBorder && !borderColors.isMonochrome() ) )
+    {
+        return false;
+    }
+
+    const QskVertex::Color fillColor =
+        hasFill ? fillGradient.rgbStart() : QskVertex::Color();
+
+    const QskVertex::Color borderColor =
+        hasBorder ? borderColors.left().rgbStart() : QskVertex::Color();
+
+    const auto material = this->material();
+
+    if ( material == qskMaterialColorVertex )
+    {
+        if ( hasFill && hasBorder && ( d->fillColor == d->borderColor ) )
+            return false; // we can't tell the vertices apart
+
+        /*
+            Instead of creating the geometry from scratch we replace
+            the colors of the existing vertices. Vertices with other
+            colors are from invisible parts of the box.
+         */
+
+        auto p = d->geometry.vertexDataAsColoredPoint2D();
+
+        for ( int i = 0; i < d->geometry.vertexCount(); i++, p++ )
+        {
+            const QskVertex::Color c( p->r, p->g, p->b, p->a );
+
+            if ( hasFill && ( c == d->fillColor ) )
+                p->set( p->x, p->y, fillColor.r, fillColor.g, fillColor.b, fillColor.a );
+            else if ( hasBorder && ( c == d->borderColor ) )
+                p->set( p->x, p->y, borderColor.r, borderColor.g, borderColor.b, borderColor.a );
+        }
+
+        markDirty( QSGNode::DirtyGeometry );
     }
+    else if ( material != QskBoxSdfMaterial::instance() )
+    {
+        auto flatMaterial = static_cast< QSGFlatColorMaterial* >( material );
+
+        flatMaterial->setColor( hasFill
+            ? fillGradient.rgbStart() : borderColors.left().rgbStart() );
+
+        markDirty( QSGNode::DirtyMaterial );
+    }
+    else
+    {
+        return false;
+    }
+
+    d->fillColor = fillColor;
+    d->borderColor = borderColor;
+
+    return true;
 }
 
-void QskBoxRectangleNode::setMonochrome( bool on )
+void QskBoxRectangleNode::setMaterialType( MaterialType type )
 {
     const auto material = this->material();
 
-    if ( on == ( material != qskMaterialColorVertex ) )
+    MaterialType oldType = FlatColor;
+    if ( material == qskMaterialColorVertex )
+        oldType = VertexColor;
+    else if ( material == QskBoxSdfMaterial::instance() )
+        oldType = DistanceField;
+
+    if ( type == oldType )
         return;
 
     Q_D( QskBoxRectangleNode );
 
     d->geometry.allocate( 0 );
 
-    if ( on )
+    const QSGGeometry::AttributeSet* attributes;
+
+    switch( type )
     {
-        setMaterial( new QSGFlatColorMaterial() );
+        case FlatColor:
+        {
+            setMaterial( new QSGFlatColorMaterial() );
+            attributes = &QSGGeometry::defaultAttributes_Point2D();
+
+            break;
+        }
+        case DistanceField:
+        {
+            setMaterial( QskBoxSdfMaterial::instance() );
+            attributes = &QskBoxSdfMaterial::attributes();
 
-        const QSGGeometry g( QSGGeometry::defaultAttributes_Point2D(), 0 );
-        memcpy( ( void* ) &d->geometry, ( void* ) &g, sizeof( QSGGeometry ) );
+            break;
+        }
+        default:
+        {
+            setMaterial( qskMaterialColorVertex );
+            attributes = &QSGGeometry::defaultAttributes_ColoredPoint2D();
+        }
     }
-    else
-    {
-        setMaterial( qskMaterialColorVertex );
+
+    if ( oldType == FlatColor )
         delete material;
 
-        const QSGGeometry g( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 );
-        memcpy( ( void* ) &d->geometry, ( void* ) &g, sizeof( QSGGeometry ) );
-    }
+    const QSGGeometry g( *attributes, 0 );
+    memcpy( ( void* ) &d->geometry, ( void* ) &g, sizeof( QSGGeometry ) );
 }
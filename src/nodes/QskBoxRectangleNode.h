@@ -31,8 +31,50 @@ class QSK_EXPORT QskBoxRectangleNode : public QSGGeometryNode
     void updateNode( const QRectF& rect,
         const QskBoxShapeMetrics&, const QskGradient& );
 
+    /*
+        Boxes with a monochrome fill and a border of uniform width and color
+        can be rendered from a single quad using a signed distance function
+        ( QskBoxSdfMaterial ). Everything else falls back to the tessellation
+        of the corners.
+     */
+    void setDistanceFieldEnabled( bool );
+    bool isDistanceFieldEnabled() const;
+
+    enum ColorPolicy
+    {
+        /*
+            All boxes are rendered with colored vertices sharing the same
+            material, what is good for the batching. When only monochrome
+            colors have changed, the colors of the existing vertices are
+            rewritten instead of creating the geometry from scratch.
+         */
+        VertexColors,
+
+        /*
+            Boxes, that can be done with one color, are rendered by a flat
+            color material. This saves the memory for the colors and a color
+            change does not touch the geometry at all, but the node can't
+            be batched with boxes of a different color.
+         */
+        FlatColors
+    };
+
+    void setColorPolicy( ColorPolicy );
+    ColorPolicy colorPolicy() const;
+
   private:
-    void setMonochrome( bool on );
+    enum MaterialType
+    {
+        VertexColor,
+        FlatColor,
+        DistanceField
+    };
+
+    void setMaterialType( MaterialType );
+    bool updateColors( bool hasFill, bool hasBorder,
+        const QskBoxBorderColors&, const QskGradient& );
+    bool updateDistanceField( const QskBoxShapeMetrics&,
+        const QskBoxBorderMetrics&, const QskBoxBorderColors&, const QskGradient& );
 
     Q_DECLARE_PRIVATE( QskBoxRectangleNode )
 };
@@ -20,15 +20,18 @@
 static inline QskVertex::Line* qskAllocateLines(
     QSGGeometry& geometry, int lineCount )
 {
-    geometry.allocate( 2 * lineCount ); // 2 points per line
-    return reinterpret_cast< QskVertex::Line* >( geometry.vertexData() );
+    return QskVertex::allocateLineCapacity< QskVertex::Line >( geometry, lineCount );
 }
 
 static inline QskVertex::ColoredLine* qskAllocateColoredLines(
     QSGGeometry& geometry, int lineCount )
 {
-    geometry.allocate( 2 * lineCount ); // 2 points per line
-    return reinterpret_cast< QskVertex::ColoredLine* >( geometry.vertexData() );
+    return QskVertex::allocateLineCapacity< QskVertex::ColoredLine >( geometry, lineCount );
+}
+
+static inline void qskFillCapacity( QSGGeometry& geometry, int lineCount )
+{
+    QskVertex::fillCapacity( geometry, 2 * lineCount ); // 2 points per line
 }
 
 static inline QskGradient qskEffectiveGradient(
@@ -116,9 +119,12 @@ void QskBox::renderBorderGeometry(
     const QskBoxMetrics metrics( rect, shape, border );
     const QskBoxBasicStroker stroker( metrics );
 
-    const auto lines = qskAllocateLines( geometry, stroker.borderCount() );
-    if ( lines )
+    const auto lineCount = stroker.borderCount();
+
+    if ( auto lines = qskAllocateLines( geometry, lineCount ) )
         stroker.setBorderLines( lines );
+
+    qskFillCapacity( geometry, lineCount );
 }
 
 void QskBox::renderFillGeometry(
@@ -136,8 +142,12 @@ void QskBox::renderFillGeometry(
     const QskBoxMetrics metrics( rect, shape, border );
     QskBoxBasicStroker stroker( metrics );
 
-    if ( auto lines = qskAllocateLines( geometry, stroker.fillCount() ) )
+    const auto lineCount = stroker.fillCount();
+
+    if ( auto lines = qskAllocateLines( geometry, lineCount ) )
         stroker.setFillLines( lines );
+
+    qskFillCapacity( geometry, lineCount );
 }
 
 void QskBox::renderBox( const QRectF& rect,
@@ -181,6 +191,8 @@ void QskBox::renderBox( const QRectF& rect,
         auto borderLines = borderCount ? lines + fillCount : nullptr;
 
         stroker.setBoxLines( borderLines, fillLines );
+
+        qskFillCapacity( geometry, borderCount + fillCount );
     }
     else
     {
@@ -211,5 +223,7 @@ void QskBox::renderBox( const QRectF& rect,
             l[0].p1 = l[-1].p2;
             l[0].p2 = l[+1].p1;
         }
+
+        qskFillCapacity( geometry, fillCount + borderCount + extraLine );
     }
 }
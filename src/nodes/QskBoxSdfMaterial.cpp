@@ -0,0 +1,282 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskBoxSdfMaterial.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskGradient.h"
+
+#include <qglobalstatic.h>
+#include <qrect.h>
+#include <qsgmaterialshader.h>
+
+// QSGMaterialRhiShader became QSGMaterialShader in Qt6
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    #include <QSGMaterialRhiShader>
+    using RhiShader = QSGMaterialRhiShader;
+#else
+    using RhiShader = QSGMaterialShader;
+#endif
+
+Q_GLOBAL_STATIC( QskBoxSdfMaterial, qskBoxSdfMaterial )
+
+namespace
+{
+    class ShaderRhi final : public RhiShader
+    {
+      public:
+        ShaderRhi()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderFileName( VertexStage, root + "boxsdf.vert.qsb" );
+            setShaderFileName( FragmentStage, root + "boxsdf.frag.qsb" );
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial*, QSGMaterial* ) override
+        {
+            Q_ASSERT( state.uniformData()->size() >= 68 );
+
+            auto data = state.uniformData()->data();
+            bool changed = false;
+
+            if ( state.isMatrixDirty() )
+            {
+                const auto matrix = state.combinedMatrix();
+                memcpy( data + 0, matrix.constData(), 64 );
+
+                changed = true;
+            }
+
+            if ( state.isOpacityDirty() )
+            {
+                const float opacity = state.opacity();
+                memcpy( data + 64, &opacity, 4 );
+
+                changed = true;
+            }
+
+            return changed;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    // the old type of shader - specific for OpenGL
+
+    class ShaderGL final : public QSGMaterialShader
+    {
+      public:
+        ShaderGL()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderSourceFile( QOpenGLShader::Vertex, root + "boxsdf.vert" );
+            setShaderSourceFile( QOpenGLShader::Fragment, root + "boxsdf.frag" );
+        }
+
+        char const* const* attributeNames() const override
+        {
+            static char const* const names[] =
+            {
+                "in_vertex", "in_coord", "in_extent", "in_radius",
+                "in_fillColor", "in_borderColor", nullptr
+            };
+
+            return names;
+        }
+
+        void initialize() override
+        {
+            QSGMaterialShader::initialize();
+
+            auto p = program();
+
+            m_matrixId = p->uniformLocation( "matrix" );
+            m_opacityId = p->uniformLocation( "opacity" );
+        }
+
+        void updateState( const QSGMaterialShader::RenderState& state,
+            QSGMaterial*, QSGMaterial* ) override
+        {
+            auto p = program();
+
+            if ( state.isMatrixDirty() )
+                p->setUniformValue( m_matrixId, state.combinedMatrix() );
+
+            if ( state.isOpacityDirty() )
+                p->setUniformValue( m_opacityId, state.opacity() );
+        }
+
+      private:
+        int m_matrixId = -1;
+        int m_opacityId = -1;
+    };
+}
+
+#endif
+
+QskBoxSdfMaterial::QskBoxSdfMaterial()
+{
+    setFlag( QSGMaterial::Blending, true );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    setFlag( QSGMaterial::SupportsRhiShader, true );
+#endif
+}
+
+QskBoxSdfMaterial* QskBoxSdfMaterial::instance()
+{
+    return qskBoxSdfMaterial;
+}
+
+const QSGGeometry::AttributeSet& QskBoxSdfMaterial::attributes()
+{
+    using A = QSGGeometry::Attribute;
+
+    static const A attributes[] =
+    {
+        A::create( 0, 2, QSGGeometry::FloatType, true ),
+        A::create( 1, 2, QSGGeometry::FloatType ),
+        A::create( 2, 3, QSGGeometry::FloatType ),
+        A::create( 3, 4, QSGGeometry::FloatType ),
+        A::create( 4, 4, QSGGeometry::UnsignedByteType ),
+        A::create( 5, 4, QSGGeometry::UnsignedByteType )
+    };
+
+    static const QSGGeometry::AttributeSet attributeSet =
+        { 6, sizeof( Vertex ), attributes };
+
+    return attributeSet;
+}
+
+void QskBoxSdfMaterial::setBox( Vertex* vertices, const QRectF& rect,
+    const float radius[ 4 ], float borderWidth,
+    QskVertex::Color fillColor, QskVertex::Color borderColor )
+{
+    // one extra pixel for the antialiasing
+    const float x1 = rect.left() - 1.0;
+    const float y1 = rect.top() - 1.0;
+    const float x2 = rect.right() + 1.0;
+    const float y2 = rect.bottom() + 1.0;
+
+    const float cx = rect.center().x();
+    const float cy = rect.center().y();
+
+    const float xy[4][2] = { { x1, y1 }, { x2, y1 }, { x1, y2 }, { x2, y2 } };
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        auto& v = vertices[i];
+
+        v.x = xy[i][0];
+        v.y = xy[i][1];
+
+        v.dx = v.x - cx;
+        v.dy = v.y - cy;
+
+        v.halfWidth = 0.5 * rect.width();
+        v.halfHeight = 0.5 * rect.height();
+        v.borderWidth = borderWidth;
+
+        for ( int j = 0; j < 4; j++ )
+            v.radius[j] = radius[j];
+
+        v.fillColor = fillColor;
+        v.borderColor = borderColor;
+    }
+}
+
+bool QskBoxSdfMaterial::setBox( Vertex* vertices, const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& fillGradient )
+{
+    if ( fillGradient.isValid() && !fillGradient.isMonochrome() )
+        return false;
+
+    const auto size = rect.size();
+
+    qreal borderWidth = 0.0;
+
+    if ( !borderMetrics.isNull() )
+    {
+        const auto metrics = borderMetrics.toAbsolute( size );
+
+        if ( !metrics.isEquidistant() || !borderColors.isMonochrome() )
+            return false;
+
+        borderWidth = metrics.widths().left();
+    }
+
+    const auto absoluteShape = shape.toAbsolute( size );
+
+    // bottomRight, topRight, bottomLeft, topLeft
+    const Qt::Corner corners[] = { Qt::BottomRightCorner,
+        Qt::TopRightCorner, Qt::BottomLeftCorner, Qt::TopLeftCorner };
+
+    const qreal maxRadius = 0.5 * std::min( size.width(), size.height() );
+
+    float radius[ 4 ];
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        const auto r = absoluteShape.radius( corners[i] );
+
+        if ( !qFuzzyCompare( r.width(), r.height() ) )
+            return false; // elliptic corners
+
+        radius[i] = qBound( 0.0, r.width(), maxRadius );
+    }
+
+    const QskVertex::Color transparent( 0, 0, 0, 0 );
+
+    const QskVertex::Color fillColor = fillGradient.isValid()
+        ? QskVertex::Color( fillGradient.rgbStart() ) : transparent;
+
+    const QskVertex::Color borderColor = ( borderWidth > 0.0 )
+        ? QskVertex::Color( borderColors.left().rgbStart() ) : fillColor;
+
+    setBox( vertices, rect, radius, borderWidth, fillColor, borderColor );
+
+    return true;
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+QSGMaterialShader* QskBoxSdfMaterial::createShader() const
+{
+    if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+        return new ShaderGL();
+
+    return new ShaderRhi();
+}
+
+#else
+
+QSGMaterialShader* QskBoxSdfMaterial::createShader(
+    QSGRendererInterface::RenderMode ) const
+{
+    return new ShaderRhi();
+}
+
+#endif
+
+QSGMaterialType* QskBoxSdfMaterial::type() const
+{
+    static QSGMaterialType staticType;
+    return &staticType;
+}
+
+int QskBoxSdfMaterial::compare( const QSGMaterial* ) const
+{
+    // all parameters are vertex attributes
+    return 0;
+}
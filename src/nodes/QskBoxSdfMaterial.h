@@ -0,0 +1,84 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_BOX_SDF_MATERIAL_H
+#define QSK_BOX_SDF_MATERIAL_H
+
+#include "QskGlobal.h"
+#include "QskVertex.h"
+
+#include <qsgmaterial.h>
+#include <qsggeometry.h>
+
+class QRectF;
+class QskBoxShapeMetrics;
+class QskBoxBorderMetrics;
+class QskBoxBorderColors;
+class QskGradient;
+
+/*
+    QskBoxSdfMaterial renders a rounded box with a monochrome fill and
+    a border of uniform width and color from a single quad. The shape is
+    evaluated by a signed distance function in the fragment shader.
+
+    All parameters of a box are passed as vertex attributes, so that
+    the boxes of the same window end up in the same batch.
+ */
+class QSK_EXPORT QskBoxSdfMaterial final : public QSGMaterial
+{
+  public:
+    class Vertex
+    {
+      public:
+        float x, y;
+
+        // relative to the center of the box
+        float dx, dy;
+
+        // half of the size and the border width
+        float halfWidth, halfHeight, borderWidth;
+
+        // bottomRight, topRight, bottomLeft, topLeft
+        float radius[ 4 ];
+
+        QskVertex::Color fillColor;
+        QskVertex::Color borderColor;
+    };
+
+    // the shared instance, that is used by all nodes
+    static QskBoxSdfMaterial* instance();
+
+    static const QSGGeometry::AttributeSet& attributes();
+
+    /*
+        Writes the 4 vertices of a strip covering the box + 1 pixel
+        for the antialiasing. The radii are expected in the order
+        of Vertex::radius and to be circular.
+     */
+    static void setBox( Vertex*, const QRectF&, const float radius[ 4 ],
+        float borderWidth, QskVertex::Color fillColor, QskVertex::Color borderColor );
+
+    /*
+        Same as above, but from the metrics of a box. An invalid gradient
+        means no filling. Returns false - without writing anything - when
+        the box can't be rendered by this material: gradients, borders of
+        different widths or colors and elliptic corners.
+     */
+    static bool setBox( Vertex*, const QRectF&, const QskBoxShapeMetrics&,
+        const QskBoxBorderMetrics&, const QskBoxBorderColors&, const QskGradient& );
+
+    QskBoxSdfMaterial();
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    QSGMaterialShader* createShader() const override;
+#else
+    QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+
+    QSGMaterialType* type() const override;
+    int compare( const QSGMaterial* ) const override;
+};
+
+#endif
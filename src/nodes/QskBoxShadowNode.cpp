@@ -5,8 +5,10 @@
 
 #include "QskBoxShadowNode.h"
 #include "QskBoxShapeMetrics.h"
+#include "QskVertex.h"
 
 #include <qcolor.h>
+#include <qglobalstatic.h>
 #include <qsgmaterialshader.h>
 #include <qsgmaterial.h>
 
@@ -25,6 +27,26 @@ QSK_QT_PRIVATE_END
 
 namespace
 {
+    /*
+        All parameters of the shadow are passed as vertex attributes, so that
+        the shadows of a window can be batched. The material has no state
+        and the same instance is shared between all nodes.
+     */
+
+    class Vertex
+    {
+      public:
+        float x, y;
+        float dx, dy;
+
+        // bottomRight, topRight, bottomLeft, topLeft
+        float radius[ 4 ];
+
+        float aspectX, aspectY, blurExtent;
+
+        QskVertex::Color color;
+    };
+
     class Material final : public QSGMaterial
     {
       public:
@@ -39,12 +61,28 @@ namespace
         QSGMaterialType* type() const override;
 
         int compare( const QSGMaterial* other ) const override;
+    };
+}
+
+Q_GLOBAL_STATIC( Material, qskShadowMaterial )
+
+static const QSGGeometry::AttributeSet& qskShadowAttributes()
+{
+    using A = QSGGeometry::Attribute;
 
-        QVector2D m_aspect = QVector2D{ 1, 1 };
-        QVector4D m_radius = QVector4D{ 0, 0, 0, 0 };
-        QVector4D m_color = QVector4D{ 0, 0, 0, 1 };
-        float m_blurExtent = 0.0;
+    static const A attributes[] =
+    {
+        A::create( 0, 2, QSGGeometry::FloatType, true ),
+        A::create( 1, 2, QSGGeometry::FloatType ),
+        A::create( 2, 4, QSGGeometry::FloatType ),
+        A::create( 3, 3, QSGGeometry::FloatType ),
+        A::create( 4, 4, QSGGeometry::UnsignedByteType )
     };
+
+    static const QSGGeometry::AttributeSet attributeSet =
+        { 5, sizeof( Vertex ), attributes };
+
+    return attributeSet;
 }
 
 namespace
@@ -61,12 +99,9 @@ namespace
         }
 
         bool updateUniformData( RenderState& state,
-            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+            QSGMaterial*, QSGMaterial* ) override
         {
-            const auto matOld = static_cast< Material* >( oldMaterial );
-            const auto matNew = static_cast< Material* >( newMaterial );
-
-            Q_ASSERT( state.uniformData()->size() >= 112 );
+            Q_ASSERT( state.uniformData()->size() >= 68 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -79,34 +114,10 @@ namespace
                 changed = true;
             }
 
-            if ( matOld == nullptr || matNew->m_color != matOld->m_color )
-            {
-                memcpy( data + 64, &matNew->m_color, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_radius != matOld->m_radius )
-            {
-                memcpy( data + 80, &matNew->m_radius, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_aspect != matOld->m_aspect )
-            {
-                memcpy( data + 96, &matNew->m_aspect, 8 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_blurExtent != matOld->m_blurExtent )
-            {
-                memcpy( data + 104, &matNew->m_blurExtent, 4 );
-                changed = true;
-            }
-
             if ( state.isOpacityDirty() )
             {
                 const float opacity = state.opacity();
-                memcpy( data + 108, &opacity, 4 );
+                memcpy( data + 64, &opacity, 4 );
 
                 changed = true;
             }
@@ -135,7 +146,9 @@ namespace
 
         char const* const* attributeNames() const override
         {
-            static char const* const names[] = { "in_vertex", "in_coord", nullptr };
+            static char const* const names[] = { "in_vertex",
+                "in_coord", "in_radius", "in_extent", "in_color", nullptr };
+
             return names;
         }
 
@@ -146,15 +159,11 @@ namespace
             auto p = program();
 
             m_matrixId = p->uniformLocation( "matrix" );
-            m_aspectId = p->uniformLocation( "aspect" );
             m_opacityId = p->uniformLocation( "opacity" );
-            m_blurExtentId = p->uniformLocation( "blurExtent" );
-            m_radiusId = p->uniformLocation( "radius" );
-            m_colorId = p->uniformLocation( "color" );
         }
 
         void updateState( const QSGMaterialShader::RenderState& state,
-            QSGMaterial* newMaterial, QSGMaterial* oldMaterial) override
+            QSGMaterial*, QSGMaterial* ) override
         {
             auto p = program();
 
@@ -163,30 +172,11 @@ namespace
 
             if ( state.isOpacityDirty() )
                 p->setUniformValue( m_opacityId, state.opacity() );
-
-            bool updateMaterial = ( oldMaterial == nullptr )
-                || newMaterial->compare( oldMaterial ) != 0;
-
-            updateMaterial |= state.isCachedMaterialDataDirty();
-
-            if ( updateMaterial )
-            {
-                auto material = static_cast< const Material* >( newMaterial );
-
-                p->setUniformValue( m_aspectId, material->m_aspect );
-                p->setUniformValue( m_blurExtentId, material->m_blurExtent);
-                p->setUniformValue( m_radiusId, material->m_radius );
-                p->setUniformValue( m_colorId, material->m_color );
-            }
         }
 
       private:
         int m_matrixId = -1;
         int m_opacityId = -1;
-        int m_aspectId = -1;
-        int m_blurExtentId = -1;
-        int m_radiusId = -1;
-        int m_colorId = -1;
     };
 }
 
@@ -226,33 +216,24 @@ QSGMaterialType* Material::type() const
     return &staticType;
 }
 
-int Material::compare( const QSGMaterial* other ) const
+int Material::compare( const QSGMaterial* ) const
 {
-    auto material = static_cast< const Material* >( other );
-
-    if ( ( material->m_color == m_color )
-        && ( material->m_aspect == m_aspect )
-        && qFuzzyCompare(material->m_blurExtent, m_blurExtent)
-        && qFuzzyCompare(material->m_radius, m_radius) )
-    {
-        return 0;
-    }
-
-    return QSGMaterial::compare( other );
+    // all parameters are vertex attributes
+    return 0;
 }
 
 class QskBoxShadowNodePrivate final : public QSGGeometryNodePrivate
 {
   public:
     QskBoxShadowNodePrivate()
-        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+        : geometry( qskShadowAttributes(), 4 )
     {
     }
 
     QSGGeometry geometry;
-    Material material;
 
-    QRectF rect;
+    // the vertexes of a freshly allocated geometry are uninitialized
+    bool hasVertexes = false;
 };
 
 QskBoxShadowNode::QskBoxShadowNode()
@@ -260,8 +241,10 @@ QskBoxShadowNode::QskBoxShadowNode()
 {
     Q_D( QskBoxShadowNode );
 
+    d->geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+
     setGeometry( &d->geometry );
-    setMaterial( &d->material );
+    setMaterial( qskShadowMaterial );
 }
 
 QskBoxShadowNode::~QskBoxShadowNode()
@@ -274,45 +257,29 @@ void QskBoxShadowNode::setShadowData(
 {
     Q_D( QskBoxShadowNode );
 
-    if ( rect != d->rect )
-    {
-        d->rect = rect;
-
-        QSGGeometry::updateTexturedRectGeometry(
-            &d->geometry, d->rect, QRectF( -0.5, -0.5, 1.0, 1.0 ) );
-
-        markDirty( QSGNode::DirtyGeometry );
-
-        QVector2D aspect( 1.0, 1.0 );
-
-        if ( rect.width() >= rect.height() )
-            aspect.setX( rect.width() / rect.height() );
-        else
-            aspect.setY( rect.height() / rect.width() );
+    Vertex vertex;
 
-        if ( d->material.m_aspect != aspect )
-        {
-            d->material.m_aspect = aspect;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+    if ( rect.width() >= rect.height() )
+    {
+        vertex.aspectX = rect.width() / rect.height();
+        vertex.aspectY = 1.0;
     }
-
+    else
     {
-        const float t = std::min( d->rect.width(), d->rect.height() );
+        vertex.aspectX = 1.0;
+        vertex.aspectY = rect.height() / rect.width();
+    }
 
-        const float r1 = shape.radius( Qt::BottomRightCorner ).width();
-        const float r2 = shape.radius( Qt::TopRightCorner ).width();
-        const float r3 = shape.radius( Qt::BottomLeftCorner ).width();
-        const float r4 = shape.radius( Qt::TopLeftCorner ).width();
+    {
+        const float t = std::min( rect.width(), rect.height() );
 
-        const auto uniformRadius = QVector4D(
-            std::min( r1 / t, 1.0f ), std::min( r2 / t, 1.0f ),
-            std::min( r3 / t, 1.0f ), std::min( r4 / t, 1.0f ) );
+        const Qt::Corner corners[] = { Qt::BottomRightCorner,
+            Qt::TopRightCorner, Qt::BottomLeftCorner, Qt::TopLeftCorner };
 
-        if ( d->material.m_radius != uniformRadius )
+        for ( int i = 0; i < 4; i++ )
         {
-            d->material.m_radius = uniformRadius;
-            markDirty( QSGNode::DirtyMaterial );
+            const float r = shape.radius( corners[i] ).width();
+            vertex.radius[i] = std::min( r / t, 1.0f );
         }
     }
 
@@ -320,25 +287,36 @@ void QskBoxShadowNode::setShadowData(
         if ( blurRadius <= 0.0 )
             blurRadius = 0.0;
 
-        const float t = 0.5 * std::min( d->rect.width(), d->rect.height() );
-        const float uniformExtent = blurRadius / t;
-
-        if ( !qFuzzyCompare( d->material.m_blurExtent, uniformExtent ) )
-        {
-            d->material.m_blurExtent = uniformExtent;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+        const float t = 0.5 * std::min( rect.width(), rect.height() );
+        vertex.blurExtent = blurRadius / t;
     }
 
+    vertex.color = QskVertex::Color( color );
+
+    const float x[] = { float( rect.left() ), float( rect.right() ) };
+    const float y[] = { float( rect.top() ), float( rect.bottom() ) };
+
+    auto vertices = static_cast< Vertex* >( d->geometry.vertexData() );
+
+    bool isDirty = !d->hasVertexes;
+
+    for ( int i = 0; i < 4; i++ )
     {
-        const auto a = color.alphaF();
+        vertex.x = x[ i % 2 ];
+        vertex.y = y[ i / 2 ];
 
-        const QVector4D c( color.redF() * a, color.greenF() * a, color.blueF() * a, a );
+        vertex.dx = ( i % 2 ) ? 0.5 : -0.5;
+        vertex.dy = ( i / 2 ) ? 0.5 : -0.5;
 
-        if ( d->material.m_color != c )
+        if ( !d->hasVertexes || memcmp( vertices + i, &vertex, sizeof( Vertex ) ) != 0 )
         {
-            d->material.m_color = c;
-            markDirty( QSGNode::DirtyMaterial );
+            vertices[i] = vertex;
+            isDirty = true;
         }
     }
+
+    d->hasVertexes = true;
+
+    if ( isDirty )
+        markDirty( QSGNode::DirtyGeometry );
 }
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskBoxesNode.h"
+#include "QskBoxSdfMaterial.h"
+#include "QskVertex.h"
+
+#include <qbytearray.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+#include <cstring>
+
+using Vertex = QskBoxSdfMaterial::Vertex;
+
+// indexes are unsigned short
+static constexpr int qskMaxBoxCount = 0xffff / 4;
+
+class QskBoxesNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskBoxesNodePrivate()
+        : geometry( QskBoxSdfMaterial::attributes(), 0, 0 )
+    {
+    }
+
+    QSGGeometry geometry;
+    int boxCount = 0;
+};
+
+QskBoxesNode::QskBoxesNode()
+    : QSGGeometryNode( *new QskBoxesNodePrivate )
+{
+    Q_D( QskBoxesNode );
+
+    d->geometry.setDrawingMode( QSGGeometry::DrawTriangles );
+
+    setGeometry( &d->geometry );
+    setMaterial( QskBoxSdfMaterial::instance() );
+}
+
+QskBoxesNode::~QskBoxesNode()
+{
+}
+
+void QskBoxesNode::setBoxCount( int count )
+{
+    Q_D( QskBoxesNode );
+
+    count = qBound( 0, count, qskMaxBoxCount );
+    if ( count == d->boxCount )
+        return;
+
+    auto& geometry = d->geometry;
+
+    if ( ( 4 * count > geometry.vertexCount() ) || ( 6 * count > geometry.indexCount() ) )
+    {
+        // growing the capacity discards the vertices of the existing boxes
+
+        const QByteArray vertices( static_cast< const char* >( geometry.vertexData() ),
+            4 * d->boxCount * sizeof( Vertex ) );
+
+        QskVertex::allocateVertexes( geometry, 4 * count, 6 * count );
+        memcpy( geometry.vertexData(), vertices.constData(), vertices.size() );
+    }
+
+    if ( count > d->boxCount )
+    {
+        auto vertices = static_cast< Vertex* >( geometry.vertexData() );
+
+        memset( vertices + 4 * d->boxCount, 0,
+            4 * ( count - d->boxCount ) * sizeof( Vertex ) );
+    }
+
+    auto indexes = geometry.indexDataAsUShort();
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const quint16 k = 4 * i;
+
+        // the vertices of a box are ordered like a triangle strip
+        *indexes++ = k;
+        *indexes++ = k + 1;
+        *indexes++ = k + 2;
+        *indexes++ = k + 2;
+        *indexes++ = k + 1;
+        *indexes++ = k + 3;
+    }
+
+    QskVertex::fillCapacity( geometry, 4 * count, 6 * count );
+
+    d->boxCount = count;
+
+    markDirty( QSGNode::DirtyGeometry );
+}
+
+int QskBoxesNode::boxCount() const
+{
+    return d_func()->boxCount;
+}
+
+bool QskBoxesNode::setBox( int index, const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& fillGradient )
+{
+    Q_D( QskBoxesNode );
+
+    if ( index < 0 || index >= d->boxCount )
+        return false;
+
+    Vertex box[ 4 ];
+
+    if ( !QskBoxSdfMaterial::setBox( box, rect,
+        shape, borderMetrics, borderColors, fillGradient ) )
+    {
+        return false;
+    }
+
+    auto vertices = static_cast< Vertex* >( d->geometry.vertexData() ) + 4 * index;
+
+    if ( memcmp( vertices, box, sizeof( box ) ) != 0 )
+    {
+        memcpy( vertices, box, sizeof( box ) );
+        markDirty( QSGNode::DirtyGeometry );
+    }
+
+    return true;
+}
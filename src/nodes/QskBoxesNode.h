@@ -0,0 +1,50 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_BOXES_NODE_H
+#define QSK_BOXES_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskBoxShapeMetrics;
+class QskBoxBorderMetrics;
+class QskBoxBorderColors;
+class QskGradient;
+
+class QskBoxesNodePrivate;
+
+/*
+    QskBoxesNode renders a series of boxes - f.e the segments of a bar
+    or the bullets of a page indicator - from one geometry. Each box is a
+    quad of the signed distance field material ( QskBoxSdfMaterial ),
+    so only boxes, that can be expressed by this material, are supported.
+
+    Boxes are updated by index and the geometry is only marked dirty,
+    when the vertices of a box have changed.
+ */
+class QSK_EXPORT QskBoxesNode : public QSGGeometryNode
+{
+  public:
+    QskBoxesNode();
+    ~QskBoxesNode() override;
+
+    // boxes being added are invisible until being set
+    void setBoxCount( int );
+    int boxCount() const;
+
+    /*
+        Returns false, when the box can't be rendered by QskBoxesNode:
+        gradients, borders of different widths or colors and elliptic corners.
+        An invalid gradient means no filling.
+     */
+    bool setBox( int index, const QRectF&, const QskBoxShapeMetrics&,
+        const QskBoxBorderMetrics&, const QskBoxBorderColors&, const QskGradient& );
+
+  private:
+    Q_DECLARE_PRIVATE( QskBoxesNode )
+};
+
+#endif
@@ -9,87 +9,363 @@
 QSK_QT_PRIVATE_BEGIN
 #include <private/qrhi_p.h>
 #include <private/qsgplaintexture_p.h>
+#include <private/qsgtexture_p.h>
 QSK_QT_PRIVATE_END
 
 #include <qcoreapplication.h>
+#include <qhash.h>
+#include <qimage.h>
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    #include <qopenglcontext.h>
+    #include <qopenglfunctions.h>
+#endif
+
+#include <bitset>
+#include <cstring>
+
+/*
+    Qt creates tables of 1024 colors, while Chrome, Firefox, and Android
+    seem to use 256 colors only ( according to maybe outdated sources
+    from the internet ),
+
+    With 256 ramps the atlas needs 256KB per QRhi.
+ */
+static constexpr int qskRampSize = 256;
+static constexpr int qskMaxRampCount = 256;
 
 namespace
 {
-    class Texture : public QSGPlainTexture
+    class HashKey
     {
       public:
-        Texture( const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+        inline bool operator==( const HashKey& other ) const
         {
-            /*
-                Qt creates tables of 1024 colors, while Chrome, Firefox, and Android
-                seem to use 256 colors only ( according to maybe outdated sources
-                from the internet ),
-             */
+            return stops == other.stops;
+        }
 
-            const int size = qBound( 256, 2 * stops.count(), 1024 );
-            setImage( QskRgb::colorTable( size, stops ) );
+        QskGradientStops stops;
+    };
 
-            const auto wrapMode = this->wrapMode( spreadMode );
+    inline size_t qHash( const HashKey& key, size_t seed = 0 )
+    {
+        QskHashValue hash = seed + key.stops.count();
+
+        for ( const auto& stop : key.stops )
+            hash = stop.hash( hash );
+
+        return hash;
+    }
 
-            setHorizontalWrapMode( wrapMode );
-            setVerticalWrapMode( wrapMode );
+    class RampTexture : public QSGPlainTexture
+    {
+      public:
+        RampTexture()
+        {
+            setHorizontalWrapMode( QSGTexture::ClampToEdge );
+            setVerticalWrapMode( QSGTexture::ClampToEdge );
 
             setFiltering( QSGTexture::Linear );
         }
 
+        void commit( QRhi* rhi, QRhiResourceUpdateBatch* updates )
+        {
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+            updateRhiTexture( rhi, updates );
+#else
+            commitTextureOperations( rhi, updates );
+#endif
+        }
+    };
+
+    class Atlas : public RampTexture
+    {
+      public:
+        Atlas()
+            : m_image( qskRampSize, qskMaxRampCount, QImage::Format_RGBA8888_Premultiplied )
+        {
+            m_image.fill( Qt::transparent );
+            m_rows.reserve( qskMaxRampCount );
+        }
+
+        ~Atlas() override
+        {
+            for ( const auto& ramp : qAsConst( m_standaloneRamps ) )
+                delete ramp.texture;
+        }
+
+        void acquire( const QskGradientStops& stops )
+        {
+            const HashKey key { stops };
+
+            const int row = m_hashTable.value( key, -1 );
+            if ( row >= 0 )
+            {
+                m_rows[ row ].refCount++;
+                return;
+            }
+
+            auto it = m_standaloneRamps.find( key );
+            if ( it != m_standaloneRamps.end() )
+            {
+                it->refCount++;
+                return;
+            }
+
+            if ( insert( stops ) < 0 )
+            {
+                /*
+                    All rows are in use: replacing one of them would
+                    modify the colors of draw calls from the current frame.
+                 */
+                auto texture = new RampTexture();
+                texture->setImage( QskRgb::colorTable( qskRampSize, stops ) );
+
+                m_standaloneRamps.insert( key, { texture, 1 } );
+            }
+        }
+
+        void release( const QskGradientStops& stops )
+        {
+            const HashKey key { stops };
+
+            const int row = m_hashTable.value( key, -1 );
+            if ( row >= 0 )
+            {
+                // the row stays in the atlas, until it gets replaced
+                if ( m_rows[ row ].refCount > 0 )
+                    m_rows[ row ].refCount--;
+
+                return;
+            }
+
+            auto it = m_standaloneRamps.find( key );
+            if ( it != m_standaloneRamps.end() )
+            {
+                if ( --it->refCount <= 0 )
+                {
+                    delete it->texture;
+                    m_standaloneRamps.erase( it );
+                }
+            }
+        }
+
+        RampTexture* texture( const QskGradientStops& stops )
+        {
+            const auto it = m_standaloneRamps.constFind( HashKey { stops } );
+            if ( it != m_standaloneRamps.constEnd() )
+                return it->texture;
+
+            return this;
+        }
+
+        // the vertical texture coordinate of the ramp
+        qreal ramp( const QskGradientStops& stops )
+        {
+            const int row = m_hashTable.value( HashKey { stops }, -1 );
+
+            if ( row < 0 )
+            {
+                // a standalone texture with one row only
+                Q_ASSERT( m_standaloneRamps.contains( HashKey { stops } ) );
+                return 0.5;
+            }
+
+            m_rows[ row ].lastUsed = ++m_counter;
+            return ( row + 0.5 ) / qskMaxRampCount;
+        }
+
+        void commitRows( QRhi* rhi, QRhiResourceUpdateBatch* updates )
+        {
+            if ( !m_isInitialized )
+            {
+                setImage( m_image );
+                commit( rhi, updates );
+
+                m_dirtyRows.reset();
+                m_isInitialized = true;
+
+                return;
+            }
+
+            if ( m_dirtyRows.none() )
+                return;
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+            auto texture = QSGTexturePrivate::get( this )->rhiTexture();
+#else
+            auto texture = rhiTexture();
+#endif
+            if ( texture == nullptr )
+                return;
+
+            uploadRows(
+                [ texture, updates ]( int row, int count, const uchar* data )
+                {
+                    const QByteArray bytes( reinterpret_cast< const char* >( data ),
+                        4 * qskRampSize * count );
+
+                    QRhiTextureSubresourceUploadDescription desc( bytes );
+                    desc.setSourceSize( QSize( qskRampSize, count ) );
+                    desc.setDestinationTopLeft( QPoint( 0, row ) );
+
+                    updates->uploadTexture( texture,
+                        QRhiTextureUploadDescription( QRhiTextureUploadEntry( 0, 0, desc ) ) );
+                }
+            );
+        }
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        void bind() override
+        {
+            if ( !m_isInitialized )
+            {
+                setImage( m_image );
+                RampTexture::bind();
+
+                m_dirtyRows.reset();
+                m_isInitialized = true;
+
+                return;
+            }
+
+            RampTexture::bind();
+
+            if ( m_dirtyRows.none() )
+                return;
+
+            auto gl = QOpenGLContext::currentContext()->functions();
+
+            uploadRows(
+                [ gl ]( int row, int count, const uchar* data )
+                {
+                    gl->glTexSubImage2D( GL_TEXTURE_2D, 0, 0, row,
+                        qskRampSize, count, GL_RGBA, GL_UNSIGNED_BYTE, data );
+                }
+            );
+        }
+#endif
+
       private:
-        static inline QSGTexture::WrapMode wrapMode( QskGradient::SpreadMode spreadMode )
+        int insert( const QskGradientStops& stops )
         {
-            switch ( spreadMode )
+            int row = -1;
+
+            if ( m_rows.count() < qskMaxRampCount )
+            {
+                row = m_rows.count();
+                m_rows += Row();
+            }
+            else
             {
-                case QskGradient::RepeatSpread:
-                    return QSGTexture::Repeat;
+                // replacing the least recently used ramp, that is not in use
 
-                case QskGradient::ReflectSpread:
-                    return QSGTexture::MirroredRepeat;
+                for ( int i = 0; i < m_rows.count(); i++ )
+                {
+                    if ( m_rows[i].refCount > 0 )
+                        continue;
 
-                default:
-                    return QSGTexture::ClampToEdge;
+                    if ( row < 0 || m_rows[i].lastUsed < m_rows[row].lastUsed )
+                        row = i;
+                }
+
+                if ( row < 0 )
+                    return -1;
+
+                m_hashTable.remove( HashKey { m_rows[row].stops } );
             }
+
+            m_rows[row].stops = stops;
+            m_rows[row].refCount = 1;
+            m_hashTable.insert( HashKey { stops }, row );
+
+            /*
+                As the image is not shared with the texture, writing
+                into it does not detach.
+             */
+            auto line = m_image.scanLine( row );
+
+            const auto table = QskRgb::colorTable( qskRampSize, stops );
+            if ( table.isNull() )
+                memset( line, 0, 4 * qskRampSize );
+            else
+                memcpy( line, table.constBits(), 4 * qskRampSize );
+
+            m_dirtyRows.set( row );
+
+            return row;
         }
-    };
 
-    class HashKey
-    {
-      public:
-        inline bool operator==( const HashKey& other ) const
+        template< typename T >
+        void uploadRows( T upload )
         {
-            return rhi == other.rhi && spreadMode == other.spreadMode && stops == other.stops;
+            // uploading sequences of modified rows
+
+            const int rowCount = m_rows.count();
+
+            for ( int row = 0; row < rowCount; )
+            {
+                if ( !m_dirtyRows.test( row ) )
+                {
+                    row++;
+                    continue;
+                }
+
+                int count = 1;
+                while ( row + count < rowCount && m_dirtyRows.test( row + count ) )
+                    count++;
+
+                upload( row, count, m_image.constScanLine( row ) );
+                row += count;
+            }
+
+            m_dirtyRows.reset();
         }
 
-        const void* rhi;
-        const QskGradientStops stops;
-        const QskGradient::SpreadMode spreadMode;
-    };
+        class Row
+        {
+          public:
+            QskGradientStops stops;
+            quint64 lastUsed = 0;
 
-    inline size_t qHash( const HashKey& key, size_t seed = 0 )
-    {
-        size_t values = seed + key.spreadMode;
+            // number of materials holding the ramp
+            int refCount = 0;
+        };
 
-        for ( const auto& stop : key.stops )
-            values += stop.rgb();
+        class StandaloneRamp
+        {
+          public:
+            RampTexture* texture;
+            int refCount;
+        };
 
-        return values;
-    }
+        QImage m_image;
+
+        QVector< Row > m_rows;
+        QHash< HashKey, int > m_hashTable;
+
+        QHash< HashKey, StandaloneRamp > m_standaloneRamps;
+
+        std::bitset< qskMaxRampCount > m_dirtyRows;
+
+        quint64 m_counter = 0;
+        bool m_isInitialized = false;
+    };
 
     class Cache
     {
       public:
-        ~Cache() { qDeleteAll( m_hashTable ); }
+        ~Cache() { qDeleteAll( m_atlases ); }
 
         void cleanupRhi( const QRhi* );
 
-        Texture* texture( const void* rhi,
-            const QskGradientStops&, QskGradient::SpreadMode );
+        Atlas* atlas( const void* rhi );
+        Atlas* find( const void* rhi ) const;
 
       private:
-        QHash< HashKey, Texture* > m_hashTable;
-        QVector< const QRhi* > m_rhiTable; // no QSet: we usually have only one entry
+        // no QHash: we usually have only one entry
+        QVector< const void* > m_rhiTable;
+        QVector< Atlas* > m_atlases;
     };
 
     static Cache* s_cache;
@@ -107,52 +383,44 @@ static void qskCleanupRhi( const QRhi* rhi )
         s_cache->cleanupRhi( rhi );
 }
 
-Texture* Cache::texture( const void* rhi,
-    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+Atlas* Cache::find( const void* rhi ) const
+{
+    const auto index = m_rhiTable.indexOf( rhi );
+    return ( index >= 0 ) ? m_atlases[ index ] : nullptr;
+}
+
+Atlas* Cache::atlas( const void* rhi )
 {
-    const HashKey key { rhi, stops, spreadMode };
+    if ( auto atlas = find( rhi ) )
+        return atlas;
 
-    auto texture = m_hashTable[key];
-    if ( texture == nullptr )
+    if ( rhi != nullptr )
     {
-        texture = new Texture( stops, spreadMode );
-        m_hashTable[ key ] = texture;
+        auto myrhi = ( QRhi* )rhi;
+        myrhi->addCleanupCallback( qskCleanupRhi );
+    }
 
-        if ( rhi != nullptr )
-        {
-            auto myrhi = ( QRhi* )rhi;
+    auto atlas = new Atlas();
 
-            if ( !m_rhiTable.contains( myrhi ) )
-            {
-                myrhi->addCleanupCallback( qskCleanupRhi );
-                m_rhiTable += myrhi;
-            }
-        }
-    }
+    m_rhiTable += rhi;
+    m_atlases += atlas;
 
-    return texture;
+    return atlas;
 }
 
 void Cache::cleanupRhi( const QRhi* rhi )
 {
-    for ( auto it = m_hashTable.begin(); it != m_hashTable.end(); )
+    const auto index = m_rhiTable.indexOf( rhi );
+    if ( index >= 0 )
     {
-        if ( it.key().rhi == rhi )
-        {
-            delete it.value();
-            it = m_hashTable.erase( it );
-        }
-        else
-        {
-            ++it;
-        }
-    }
+        delete m_atlases[ index ];
 
-    m_rhiTable.removeAll( rhi );
+        m_rhiTable.remove( index );
+        m_atlases.remove( index );
+    }
 }
 
-QSGTexture* QskColorRamp::texture( const void* rhi,
-    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+static Atlas* qskAtlas( const void* rhi )
 {
     if ( s_cache == nullptr )
     {
@@ -167,5 +435,55 @@ QSGTexture* QskColorRamp::texture( const void* rhi,
         qAddPostRoutine( qskCleanupCache );
     }
 
-    return s_cache->texture( rhi, stops, spreadMode );
+    return s_cache->atlas( rhi );
+}
+
+void QskColorRamp::acquire( const void* rhi, const QskGradientStops& stops )
+{
+    qskAtlas( rhi )->acquire( stops );
+}
+
+void QskColorRamp::release( const void* rhi, const QskGradientStops& stops )
+{
+    // the atlas might have been gone with its QRhi
+    if ( auto atlas = s_cache ? s_cache->find( rhi ) : nullptr )
+        atlas->release( stops );
+}
+
+QSGTexture* QskColorRamp::texture( const QskGradientStops& stops )
+{
+    return qskAtlas( nullptr )->texture( stops );
+}
+
+QSGTexture* QskColorRamp::texture( QRhi* rhi,
+    QRhiResourceUpdateBatch* updates, const QskGradientStops& stops )
+{
+    auto atlas = qskAtlas( rhi );
+
+    auto texture = atlas->texture( stops );
+    if ( texture == atlas )
+        atlas->commitRows( rhi, updates );
+    else
+        texture->commit( rhi, updates );
+
+    return texture;
+}
+
+QVector4D QskColorRamp::rampCoordinates( const void* rhi,
+    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    const auto y = qskAtlas( rhi )->ramp( stops );
+
+    const float offset = 0.5f / qskRampSize;
+    return QVector4D( y, spreadMode, offset, 1.0f - 2.0f * offset );
+}
+
+int QskColorRamp::rampSize()
+{
+    return qskRampSize;
+}
+
+int QskColorRamp::maxRampCount()
+{
+    return qskMaxRampCount;
 }
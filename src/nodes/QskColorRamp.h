@@ -9,12 +9,49 @@
 #include "QskGlobal.h"
 #include "QskGradient.h"
 
+#include <qvector4d.h>
+
 class QSGTexture;
+class QRhi;
+class QRhiResourceUpdateBatch;
 
 namespace QskColorRamp
 {
-    QSGTexture* texture( const void* rhi,
+    /*
+        The color ramps are rows of an atlas texture, that is shared by all
+        gradients of the same QRhi ( nullptr for OpenGL ). The atlas has a fixed
+        number of rows and the least recently used ramp is replaced, when
+        running out of space.
+
+        A ramp needs to be acquired before it can be used for rendering,
+        and its row can't be replaced before it has been released. When all
+        rows are in use a standalone texture is created instead.
+
+        As the atlas is ClampToEdge, the spread mode has to be done in
+        the shader: see rampCoordinates() and the gradient shaders.
+     */
+
+    void acquire( const void* rhi, const QskGradientStops& );
+    void release( const void* rhi, const QskGradientStops& );
+
+    // OpenGL: modified rows are uploaded, when binding the texture
+    QSGTexture* texture( const QskGradientStops& );
+
+    // RHI: modified rows are added to the resource updates
+    QSGTexture* texture( QRhi*, QRhiResourceUpdateBatch*, const QskGradientStops& );
+
+    /*
+        x: vertical texture coordinate of the ramp
+        y: QskGradient::SpreadMode
+        z, w: offset/scale for mapping [0,1] to the horizontal texture
+              coordinates without sampling beyond the first/last texel
+     */
+    QVector4D rampCoordinates( const void* rhi,
         const QskGradientStops&, QskGradient::SpreadMode );
+
+    // upper bounds
+    int rampSize();
+    int maxRampCount();
 }
 
 #endif
@@ -28,6 +28,26 @@
     using RhiShader = QSGMaterialShader;
 #endif
 
+static inline bool qskHasStops(
+    const QskGradient& gradient, const QskGradientStops& stops )
+{
+    // comparing without creating a vector for gradients with inline stops
+
+    const auto count = gradient.stopCount();
+    if ( count != stops.count() )
+        return false;
+
+    const auto gradientStops = gradient.stopData();
+
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( gradientStops[i] != stops[i] )
+            return false;
+    }
+
+    return true;
+}
+
 namespace
 {
     class GradientMaterial : public QskGradientMaterial
@@ -65,7 +85,42 @@ namespace
         virtual QSGMaterialShader* createShader() const = 0;
 #endif
 
+        ~GradientMaterial() override
+        {
+            releaseRamp();
+        }
+
         virtual bool setGradient( const QskGradient& ) = 0;
+
+        /*
+            The ramp is locked in the atlas from its first use for
+            rendering until the stops change or the material is gone.
+            So it can't be replaced by another ramp during a frame.
+         */
+        void acquireRamp( const void* rhi ) const
+        {
+            if ( !m_hasRamp )
+            {
+                QskColorRamp::acquire( rhi, stops() );
+
+                m_rampRhi = rhi;
+                m_hasRamp = true;
+            }
+        }
+
+      protected:
+        void releaseRamp()
+        {
+            if ( m_hasRamp )
+            {
+                QskColorRamp::release( m_rampRhi, stops() );
+                m_hasRamp = false;
+            }
+        }
+
+      private:
+        mutable const void* m_rampRhi = nullptr;
+        mutable bool m_hasRamp = false;
     };
 
 #ifdef SHADER_GL
@@ -85,6 +140,7 @@ namespace
         {
             m_opacityId = program()->uniformLocation( "opacity" );
             m_matrixId = program()->uniformLocation( "matrix" );
+            m_rampId = program()->uniformLocation( "ramp" );
         }
 
         void updateState( const RenderState& state,
@@ -101,8 +157,12 @@ namespace
 
             updateUniformValues( material );
 
-            auto texture = QskColorRamp::texture(
-                nullptr, material->stops(), material->spreadMode() );
+            material->acquireRamp( nullptr );
+
+            p->setUniformValue( m_rampId, QskColorRamp::rampCoordinates(
+                nullptr, material->stops(), material->spreadMode() ) );
+
+            auto texture = QskColorRamp::texture( material->stops() );
             texture->bind();
         }
 
@@ -117,6 +177,7 @@ namespace
       protected:
         int m_opacityId = -1;
         int m_matrixId = -1;
+        int m_rampId = -1;
     };
 #endif
 
@@ -139,17 +200,25 @@ namespace
                 return;
 
             auto material = static_cast< const GradientMaterial* >( newMaterial );
+            material->acquireRamp( state.rhi() );
 
-            auto texture = QskColorRamp::texture(
-                state.rhi(), material->stops(), material->spreadMode() );
+            textures[0] = QskColorRamp::texture(
+                state.rhi(), state.resourceUpdateBatch(), material->stops() );
+        }
 
-#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
-            texture->updateRhiTexture( state.rhi(), state.resourceUpdateBatch() );
-#else
-            texture->commitTextureOperations( state.rhi(), state.resourceUpdateBatch() );
-#endif
+      protected:
+        bool updateRamp( RenderState& state, const GradientMaterial* material )
+        {
+            Q_ASSERT( state.uniformData()->size() >= 112 );
+
+            material->acquireRamp( state.rhi() );
 
-            textures[0] = texture;
+            // the ramp might be a different one than for the previous material
+            const auto ramp = QskColorRamp::rampCoordinates(
+                state.rhi(), material->stops(), material->spreadMode() );
+
+            memcpy( state.uniformData()->data() + 96, &ramp, 16 );
+            return true;
         }
     };
 #endif
@@ -169,8 +238,9 @@ namespace
         {
             bool changed = false;
 
-            if ( gradient.stops() != stops() )
+            if ( !qskHasStops( gradient, stops() ) )
             {
+                releaseRamp();
                 setStops( gradient.stops() );
                 changed = true;
             }
@@ -267,7 +337,7 @@ namespace
             auto matNew = static_cast< LinearMaterial* >( newMaterial );
             auto matOld = static_cast< LinearMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 84 );
+            Q_ASSERT( state.uniformData()->size() >= 112 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -294,6 +364,8 @@ namespace
                 changed = true;
             }
 
+            changed |= updateRamp( state, matNew );
+
             return changed;
         }
     };
@@ -329,8 +401,9 @@ namespace
         {
             bool changed = false;
 
-            if ( gradient.stops() != stops() )
+            if ( !qskHasStops( gradient, stops() ) )
             {
+                releaseRamp();
                 setStops( gradient.stops() );
                 changed = true;
             }
@@ -427,7 +500,7 @@ namespace
             auto matNew = static_cast< RadialMaterial* >( newMaterial );
             auto matOld = static_cast< RadialMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 84 );
+            Q_ASSERT( state.uniformData()->size() >= 112 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -460,6 +533,8 @@ namespace
                 changed = true;
             }
 
+            changed |= updateRamp( state, matNew );
+
             return changed;
         }
     };
@@ -496,8 +571,9 @@ namespace
         {
             bool changed = false;
 
-            if ( gradient.stops() != stops() )
+            if ( !qskHasStops( gradient, stops() ) )
             {
+                releaseRamp();
                 setStops( gradient.stops() );
                 changed = true;
             }
@@ -635,7 +711,7 @@ namespace
             auto matNew = static_cast< ConicMaterial* >( newMaterial );
             auto matOld = static_cast< ConicMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 88 );
+            Q_ASSERT( state.uniformData()->size() >= 112 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -680,6 +756,8 @@ namespace
                 changed = true;
             }
 
+            changed |= updateRamp( state, matNew );
+
             return changed;
         }
     };
@@ -59,6 +59,49 @@ namespace
     };
 }
 
+/*
+    The dashes of lines with the same direction and length are translations
+    of each other. As grids or tick marks usually consist of sequences of
+    such lines we can avoid running the stroker for each of them.
+ */
+
+static int qskDashCount( const QTransform& transform,
+    int count, const QLineF* lines, const QskStippleMetrics& metrics )
+{
+    const bool doTransform = !transform.isIdentity();
+
+    Renderer renderer( metrics );
+
+    QPointF d0;
+    int dashCount0 = -1;
+
+    int dashCount = 0;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        auto p1 = lines[i].p1();
+        auto p2 = lines[i].p2();
+
+        if ( doTransform )
+        {
+            p1 = transform.map( p1 );
+            p2 = transform.map( p2 );
+        }
+
+        const auto d = p2 - p1;
+
+        if ( dashCount0 < 0 || d != d0 )
+        {
+            dashCount0 = renderer.dashCount( p1, p2 );
+            d0 = d;
+        }
+
+        dashCount += dashCount0;
+    }
+
+    return dashCount;
+}
+
 static QSGGeometry::Point2D* qskAddDashes( const QTransform& transform,
     int count, const QLineF* lines, const QskStippleMetrics& metrics,
     QSGGeometry::Point2D* points )
@@ -70,6 +113,11 @@ static QSGGeometry::Point2D* qskAddDashes( const QTransform& transform,
 
     Renderer renderer( metrics );
 
+    // the dashes of the last line, that has been sent to the stroker
+    const QSGGeometry::Point2D* dashes0 = nullptr;
+    int pointCount0 = 0;
+    QPointF p0, d0;
+
     for ( int i = 0; i < count; i++ )
     {
         auto p1 = lines[i].p1();
@@ -81,7 +129,25 @@ static QSGGeometry::Point2D* qskAddDashes( const QTransform& transform,
             p2 = transform.map( p2 );
         }
 
-        points = renderer.addDashes( points, p1.x(), p1.y(), p2.x(), p2.y() );
+        const auto d = p2 - p1;
+
+        if ( dashes0 && d == d0 )
+        {
+            const float dx = p1.x() - p0.x();
+            const float dy = p1.y() - p0.y();
+
+            for ( int j = 0; j < pointCount0; j++ )
+                points++->set( dashes0[j].x + dx, dashes0[j].y + dy );
+        }
+        else
+        {
+            dashes0 = points;
+            points = renderer.addDashes( points, p1.x(), p1.y(), p2.x(), p2.y() );
+
+            pointCount0 = points - dashes0;
+            p0 = p1;
+            d0 = d;
+        }
     }
 
     return points;
@@ -279,6 +345,8 @@ void QskLinesNode::updateLines( const QColor& color,
         || color.alpha() == 0 || count == 0 )
     {
         QskSGNode::resetGeometry( this );
+        d->dirty = true;
+
         return;
     }
 
@@ -286,7 +354,8 @@ void QskLinesNode::updateLines( const QColor& color,
 
     hash = stippleMetrics.hash( hash );
     hash = qHash( transform, hash );
-    hash = qHashBits( lines, count * sizeof( QLineF ) );
+    hash = qHash( count, hash );
+    hash = qHashBits( lines, count * sizeof( QLineF ), hash );
 
     if ( hash != d->hash )
     {
@@ -315,6 +384,8 @@ void QskLinesNode::updateGrid( const QColor& color,
     if ( !stippleMetrics.isValid() || !color.isValid() || color.alpha() == 0 )
     {
         QskSGNode::resetGeometry( this );
+        d->dirty = true;
+
         return;
     }
 
@@ -351,45 +422,32 @@ void QskLinesNode::updateGeometry( const QskStippleMetrics& stippleMetrics,
     auto& geom = d->geometry;
 
     QSGGeometry::Point2D* points = nullptr;
+    int vertexCount = 0;
 
     if ( stippleMetrics.isSolid() )
     {
         using namespace QskVertex;
 
-        geom.allocate( 2 * count );
+        vertexCount = 2 * count;
+
+        QskVertex::allocateVertexes( geom, vertexCount );
         points = geom.vertexDataAsPoint2D();
 
         points = qskAddLines( transform, count, lines, points );
     }
     else
     {
-        const bool doTransform = !transform.isIdentity();
-
-        Renderer renderer( stippleMetrics );
-
-        int lineCount = 0;
-        for ( int i = 0; i < count; i++ )
-        {
-            auto p1 = lines[i].p1();
-            auto p2 = lines[i].p2();
-
-            if ( doTransform )
-            {
-                p1 = transform.map( p1 );
-                p2 = transform.map( p2 );
-            }
-            lineCount += renderer.dashCount( p1, p2 );
-        }
+        vertexCount = 2 * qskDashCount( transform, count, lines, stippleMetrics );
 
-        d->geometry.allocate( 2 * lineCount );
-        points = d->geometry.vertexDataAsPoint2D();
+        QskVertex::allocateVertexes( geom, vertexCount );
+        points = geom.vertexDataAsPoint2D();
 
         points = qskAddDashes( transform,
             count, lines, stippleMetrics, points );
-
     }
 
-    Q_ASSERT( geom.vertexCount() == ( points - geom.vertexDataAsPoint2D() ) );
+    Q_ASSERT( vertexCount == ( points - geom.vertexDataAsPoint2D() ) );
+    QskVertex::fillCapacity( geom, vertexCount );
 }
 
 void QskLinesNode::updateGeometry(
@@ -408,12 +466,15 @@ void QskLinesNode::updateGeometry(
     const auto x2 = mapX( transform, rect.right() );
 
     QSGGeometry::Point2D* points = nullptr;
+    int vertexCount = 0;
 
     if ( stippleMetrics.isSolid() )
     {
         using namespace QskVertex;
 
-        geom.allocate( 2 * ( xValues.count() + yValues.count() ) );
+        vertexCount = 2 * ( xValues.count() + yValues.count() );
+
+        QskVertex::allocateVertexes( geom, vertexCount );
         points = geom.vertexDataAsPoint2D();
 
         points = setSolidLines( Qt::Vertical, y1, y2,
@@ -430,8 +491,10 @@ void QskLinesNode::updateGeometry(
         const auto countY = renderer.dashCount( x1, 0.0, x2, 0.0 );
         const auto count = xValues.count() * countX + yValues.count() * countY;
 
-        d->geometry.allocate( 2 * count );
-        points = d->geometry.vertexDataAsPoint2D();
+        vertexCount = 2 * count;
+
+        QskVertex::allocateVertexes( geom, vertexCount );
+        points = geom.vertexDataAsPoint2D();
 
         points = setStippledLines( Qt::Vertical, y1, y2,
             transform, xValues.count(), xValues.constData(),
@@ -442,7 +505,8 @@ void QskLinesNode::updateGeometry(
             stippleMetrics, points );
     }
 
-    Q_ASSERT( geom.vertexCount() == ( points - geom.vertexDataAsPoint2D() ) );
+    Q_ASSERT( vertexCount == ( points - geom.vertexDataAsPoint2D() ) );
+    QskVertex::fillCapacity( geom, vertexCount );
 }
 
 QSGGeometry::Point2D* QskLinesNode::setStippledLines(
@@ -8,6 +8,7 @@
 #include "QskGradient.h"
 #include "QskGradientDirection.h"
 #include "QskSGNode.h"
+#include "QskVertex.h"
 
 #include <qsgflatcolormaterial.h>
 
@@ -23,9 +24,12 @@ static void qskUpdateGeometry( const QPainterPath& path,
     const auto ts = qTriangulate( path, transform, 1, false );
 
 #if 1
-    geometry.allocate( ts.vertices.size(), ts.indices.size() );
+    // ts.vertices: x and y as separate values
+    const int vertexCount = ts.vertices.size() / 2;
+
+    auto vertexData = static_cast< float* >( QskVertex::allocateVertexes(
+        geometry, vertexCount, ts.indices.size() ) );
 
-    auto vertexData = reinterpret_cast< float* >( geometry.vertexData() );
     const auto points = ts.vertices.constData();
 
     for ( int i = 0; i < ts.vertices.count(); i++ )
@@ -33,6 +37,8 @@ static void qskUpdateGeometry( const QPainterPath& path,
 
     memcpy( geometry.indexData(), ts.indices.data(),
         ts.indices.size() * sizeof( quint16 ) );
+
+    QskVertex::fillCapacity( geometry, vertexCount, ts.indices.size() );
 #else
     /*
         As we have to iterate over the vertex buffer to copy qreal to float
@@ -185,8 +185,10 @@ void QskStrokeNode::updateNode(
         }
 
         // 2 vertices for each point
+        const int vertexCount = stroker.vertexCount() / 2;
+
         d->geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
-        d->geometry.allocate( stroker.vertexCount() / 2 );
+        QskVertex::allocateVertexes( d->geometry, vertexCount );
 
         if ( material() == qskMaterialColorVertex )
         {
@@ -195,7 +197,7 @@ void QskStrokeNode::updateNode(
             const auto v = stroker.vertices();
             auto points = d->geometry.vertexDataAsColoredPoint2D();
 
-            for ( int i = 0; i < d->geometry.vertexCount(); i++ )
+            for ( int i = 0; i < vertexCount; i++ )
             {
                 const auto j = 2 * i;
                 points[i].set( v[j], v[j + 1], c.r, c.g, c.b, c.a );
@@ -207,6 +209,8 @@ void QskStrokeNode::updateNode(
                 stroker.vertexCount() * sizeof( float ) );
         }
 
+        QskVertex::fillCapacity( d->geometry, vertexCount );
+
         markDirty( QSGNode::DirtyGeometry );
     }
 
@@ -259,16 +263,20 @@ void QskStrokeNode::updateNode( const QPolygonF& polygon,
 
     if ( true ) // TODO
     {
-        d->geometry.allocate( polygon.count() );
+        QskVertex::allocateVertexes( d->geometry, polygon.count() );
 
         if ( material() == qskMaterialColorVertex )
         {
             qskMapPolygon( polygon, transform, color, d->geometry );
+            QskVertex::fillCapacity( d->geometry, polygon.count() );
+
             markDirty( QSGNode::DirtyGeometry );
         }
         else
         {
             qskMapPolygon( polygon, transform, d->geometry );
+            QskVertex::fillCapacity( d->geometry, polygon.count() );
+
             markDirty( QSGNode::DirtyGeometry );
 
             auto flatMaterial = static_cast< QSGFlatColorMaterial* >( material() );
@@ -1,9 +1,12 @@
 #include "QskTickmarksNode.h"
 #include "QskScaleTickmarks.h"
+#include "QskVertex.h"
+#include "QskIntervalF.h"
 
 #include <QSGFlatColorMaterial>
 #include <QSGGeometryNode>
 #include <QRectF>
+#include <qhashfunctions.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgnode_p.h>
@@ -28,10 +31,6 @@ class QskTickmarksNodePrivate final : public QSGGeometryNodePrivate
     QSGGeometry geometry;
     QSGFlatColorMaterial material;
 
-    QskIntervalF boundaries;
-    QskScaleTickmarks tickmarks;
-
-    QRectF rect;
     int lineWidth = 0;
 
     QskHashValue hash = 0;
@@ -65,14 +64,21 @@ void QskTickmarksNode::update(
         markDirty( QSGNode::DirtyGeometry );
     }
 
-    const auto hash = tickmarks.hash( 17435 );
+    QskHashValue hash = tickmarks.hash( 17435 );
+
+    hash = qHashBits( &rect, sizeof( QRectF ), hash );
+    hash = qHash( boundaries.lowerBound(), hash );
+    hash = qHash( boundaries.upperBound(), hash );
+    hash = qHash( static_cast< int >( orientation ), hash );
+    hash = qHash( static_cast< int >( alignment ), hash );
 
-    if( ( hash != d->hash ) || ( rect != d->rect ) )
+    if( hash != d->hash )
     {
         d->hash = hash;
-        d->rect = rect;
 
-        d->geometry.allocate( tickmarks.tickCount() * 2 );
+        const int vertexCount = tickmarks.tickCount() * 2;
+
+        QskVertex::allocateVertexes( d->geometry, vertexCount );
         auto vertexData = d->geometry.vertexDataAsPoint2D();
 
         const qreal min = boundaries.lowerBound();
@@ -153,6 +159,8 @@ void QskTickmarksNode::update(
             }
         }
 
+        QskVertex::fillCapacity( d->geometry, vertexCount );
+
         d->geometry.markVertexDataDirty();
         markDirty( QSGNode::DirtyGeometry );
     }
@@ -5,8 +5,149 @@
 
 #include "QskVertex.h"
 
+#include <qatomic.h>
+
+#include <cstring>
+
 using namespace QskVertex;
 
+namespace
+{
+    class ArcTable
+    {
+      public:
+        ArcTable()
+        {
+            /*
+                The values are calculated in the same way as it is done
+                by the incremental iteration, so that we have the same
+                results for all step counts.
+             */
+            auto value = m_values;
+
+            for ( int stepCount = 1; stepCount <= ArcIterator::MaxTableStepCount; stepCount++ )
+            {
+                for ( const bool inverted : { false, true } )
+                {
+                    m_offsets[ stepCount ][ inverted ] = value - m_values;
+
+                    ArcIterator it;
+                    it.resetIncremental( stepCount, inverted );
+
+                    for ( ; !it.isDone(); ++it )
+                        *value++ = { it.cos(), it.sin() };
+                }
+            }
+        }
+
+        inline const ArcIterator::Value* values( int stepCount, bool inverted ) const
+        {
+            return m_values + m_offsets[ stepCount ][ inverted ];
+        }
+
+      private:
+        enum
+        {
+            // 2 * sum( stepCount + 1 )
+            ValueCount = ArcIterator::MaxTableStepCount
+                * ( ArcIterator::MaxTableStepCount + 3 )
+        };
+
+        ArcIterator::Value m_values[ ValueCount ];
+        int m_offsets[ ArcIterator::MaxTableStepCount + 1 ][ 2 ];
+    };
+}
+
+const ArcIterator::Value* ArcIterator::table( int stepCount, bool inverted )
+{
+    if ( stepCount < 1 || stepCount > MaxTableStepCount )
+        return nullptr;
+
+    // thread safe initialization, as nodes might be updated from different threads
+    static const ArcTable arcTable;
+
+    return arcTable.values( stepCount, inverted );
+}
+
+static QAtomicInt qskAllocationCount;
+
+static inline int qskCapacity( int capacity, int count )
+{
+    if ( count <= capacity )
+        return capacity;
+
+    // growing by 50% to avoid reallocations for each additional vertex
+    return qMax( count, capacity + capacity / 2 );
+}
+
+template< typename T >
+static inline void qskFillIndexes( QSGGeometry& geometry, int indexCount )
+{
+    auto indexes = static_cast< T* >( geometry.indexData() );
+    const T index = ( indexCount > 0 ) ? indexes[ indexCount - 1 ] : 0;
+
+    for ( int i = indexCount; i < geometry.indexCount(); i++ )
+        indexes[i] = index;
+}
+
+void* QskVertex::allocateVertexes(
+    QSGGeometry& geometry, int vertexCount, int indexCount )
+{
+    const auto vertexCapacity = qskCapacity( geometry.vertexCount(), vertexCount );
+    const auto indexCapacity = qskCapacity( geometry.indexCount(), indexCount );
+
+    if ( ( vertexCapacity != geometry.vertexCount() )
+        || ( indexCapacity != geometry.indexCount() ) )
+    {
+        geometry.allocate( vertexCapacity, indexCapacity );
+        qskAllocationCount.ref();
+    }
+
+    return geometry.vertexData();
+}
+
+void QskVertex::fillCapacity( QSGGeometry& geometry, int vertexCount, int indexCount )
+{
+    if ( geometry.indexCount() > 0 )
+    {
+        // the unused vertexes are not referenced
+
+        if ( geometry.indexType() == QSGGeometry::UnsignedShortType )
+            qskFillIndexes< quint16 >( geometry, indexCount );
+        else
+            qskFillIndexes< quint32 >( geometry, indexCount );
+
+        return;
+    }
+
+    if ( vertexCount >= geometry.vertexCount() )
+        return;
+
+    /*
+        Duplicates of the last vertex result in triangles/lines
+        without any area/length. Those are dropped by the rasterizer.
+     */
+
+    auto data = static_cast< char* >( geometry.vertexData() );
+    const auto size = geometry.sizeOfVertex();
+
+    if ( vertexCount <= 0 )
+    {
+        memset( data, 0, geometry.vertexCount() * size );
+        return;
+    }
+
+    const auto last = data + ( vertexCount - 1 ) * size;
+
+    for ( int i = vertexCount; i < geometry.vertexCount(); i++ )
+        memcpy( data + i * size, last, size );
+}
+
+int QskVertex::allocationCount()
+{
+    return qskAllocationCount.loadRelaxed();
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 #include <qdebug.h>
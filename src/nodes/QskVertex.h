@@ -186,9 +186,54 @@ namespace QskVertex
 
 namespace QskVertex
 {
-    class ArcIterator
+    /*
+        QSGGeometry::allocate releases and mallocs the buffer, whenever the
+        number of vertexes changes. For geometries that are updated frequently
+        - f.e during resize animations - this results in memory allocations
+        for almost every frame.
+
+        allocateVertexes() treats the buffer of the geometry as storage with
+        a capacity, that grows in steps and never shrinks - unless being asked
+        for by calling QSGGeometry::allocate( 0 ) explicitly. After writing
+        the vertexes fillCapacity() has to be called, so that the unused
+        vertexes ( indexes ) end up as degenerated primitives.
+     */
+    QSK_EXPORT void* allocateVertexes( QSGGeometry&,
+        int vertexCount, int indexCount = 0 );
+
+    QSK_EXPORT void fillCapacity( QSGGeometry&,
+        int vertexCount, int indexCount = 0 );
+
+    template< class Line >
+    static inline Line* allocateLineCapacity( QSGGeometry& geometry, int lineCount )
+    {
+        return static_cast< Line* >( allocateVertexes( geometry, 2 * lineCount ) );
+    }
+
+    // number of buffers, that had to be ( re- )allocated by allocateVertexes()
+    QSK_EXPORT int allocationCount();
+}
+
+namespace QskVertex
+{
+    /*
+        Iterating over the points of a quarter of a circle.
+
+        The points for step counts up to MaxTableStepCount are precalculated,
+        so that iterating is not more than reading from a table. Larger
+        step counts are calculated by incremental rotations.
+     */
+    class QSK_EXPORT ArcIterator
     {
       public:
+        static constexpr int MaxTableStepCount = 32;
+
+        struct Value
+        {
+            double cos;
+            double sin;
+        };
+
         inline ArcIterator() = default;
 
         inline ArcIterator( int stepCount, bool inverted = false )
@@ -198,6 +243,91 @@ namespace QskVertex
 
         void reset( int stepCount, bool inverted = false )
         {
+            m_values = table( stepCount, inverted );
+
+            if ( m_values )
+            {
+                m_inverted = inverted;
+                m_stepIndex = 0;
+                m_stepCount = stepCount;
+            }
+            else
+            {
+                resetIncremental( stepCount, inverted );
+            }
+        }
+
+        inline bool isInverted() const { return m_inverted; }
+
+        inline double cos() const
+        {
+            return m_values ? m_values[ m_stepIndex ].cos : m_cos;
+        }
+
+        inline double sin() const
+        {
+            if ( m_values )
+                return m_values[ m_stepIndex ].sin;
+
+            return m_inverted ? -m_sin : m_sin;
+        }
+
+        inline int step() const { return m_stepIndex; }
+        inline int stepCount() const { return m_stepCount; }
+        inline bool isDone() const { return m_stepIndex > m_stepCount; }
+
+        inline void increment()
+        {
+            if ( m_values )
+                m_stepIndex++;
+            else
+                incrementIncremental();
+        }
+
+        inline void decrement()
+        {
+            revert();
+            increment();
+            revert();
+        }
+
+        inline void operator++() { increment(); }
+
+        static int segmentHint( double radius )
+        {
+            const double arcLength = radius * M_PI_2;
+            return qBound( 3, qCeil( arcLength / 3.0 ), 18 ); // every 3 pixels
+        }
+
+        inline void revert()
+        {
+            m_inverted = !m_inverted;
+            m_stepIndex = m_stepCount - m_stepIndex;
+
+            if ( m_values )
+                m_values = table( m_stepCount, m_inverted );
+            else
+                m_sin = -m_sin;
+        }
+
+        ArcIterator reverted() const
+        {
+            ArcIterator it = *this;
+            it.revert();
+
+            return it;
+        }
+
+        /*
+            stepCount + 1 points, starting at 90° - or 0° when inverted.
+            nullptr for step counts that are not in the table.
+         */
+        static const Value* table( int stepCount, bool inverted );
+
+        // bypassing the table
+        void resetIncremental( int stepCount, bool inverted = false )
+        {
+            m_values = nullptr;
             m_inverted = inverted;
 
             if ( inverted )
@@ -219,16 +349,8 @@ namespace QskVertex
             m_sinStep = qFastSin( angleStep );
         }
 
-        inline bool isInverted() const { return m_inverted; }
-
-        inline double cos() const { return m_cos; }
-        inline double sin() const { return m_inverted ? -m_sin : m_sin; }
-
-        inline int step() const { return m_stepIndex; }
-        inline int stepCount() const { return m_stepCount; }
-        inline bool isDone() const { return m_stepIndex > m_stepCount; }
-
-        inline void increment()
+      private:
+        void incrementIncremental()
         {
             if ( ++m_stepIndex >= m_stepCount )
             {
@@ -260,38 +382,8 @@ namespace QskVertex
             }
         }
 
-        inline void decrement()
-        {
-            revert();
-            increment();
-            revert();
-        }
-
-        inline void operator++() { increment(); }
-
-        static int segmentHint( double radius )
-        {
-            const double arcLength = radius * M_PI_2;
-            return qBound( 3, qCeil( arcLength / 3.0 ), 18 ); // every 3 pixels
-        }
+        const Value* m_values = nullptr;
 
-        inline void revert()
-        {
-            m_inverted = !m_inverted;
-            m_stepIndex = m_stepCount - m_stepIndex;
-
-            m_sin = -m_sin;
-        }
-
-        ArcIterator reverted() const
-        {
-            ArcIterator it = *this;
-            it.revert();
-
-            return it;
-        }
-
-      private:
         double m_cos;
         double m_sin;
 
@@ -0,0 +1,40 @@
+#version 440
+
+layout( location = 0 ) in vec2 texCoord;
+layout( location = 1 ) in vec2 coord;
+
+layout( location = 0 ) out vec4 fragColor;
+
+/*
+    coord: relative to the center of the box
+    extent: half of the size
+    radius: bottomRight, topRight, bottomLeft, topLeft
+ */
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    vec4 radius;
+    vec2 extent;
+    float opacity;
+} ubuf;
+
+layout( binding = 1 ) uniform sampler2D source;
+
+float boxDistance( in vec2 pos, in vec2 size, in vec4 radii )
+{
+    radii.xy = ( pos.x > 0.0 ) ? radii.xy : radii.zw;
+    radii.x = ( pos.y > 0.0 ) ? radii.x : radii.y;
+
+    vec2 q = abs( pos ) - size + radii.x;
+    return min( max( q.x, q.y ), 0.0 ) + length( max( q, 0.0 ) ) - radii.x;
+}
+
+void main()
+{
+    float d = boxDistance( coord, ubuf.extent, ubuf.radius );
+    float aa = 0.5 * fwidth( d );
+
+    float coverage = 1.0 - smoothstep( -aa, aa, d );
+
+    fragColor = texture( source, texCoord ) * ( coverage * ubuf.opacity );
+}
@@ -0,0 +1,31 @@
+#ifdef GL_ES
+#extension GL_OES_standard_derivatives : enable
+#endif
+
+uniform sampler2D source;
+
+uniform highp vec4 radius;
+uniform highp vec2 extent;
+uniform lowp float opacity;
+
+varying highp vec2 texCoord;
+varying highp vec2 coord;
+
+highp float boxDistance( in highp vec2 pos, in highp vec2 size, in highp vec4 radii )
+{
+    radii.xy = ( pos.x > 0.0 ) ? radii.xy : radii.zw;
+    radii.x = ( pos.y > 0.0 ) ? radii.x : radii.y;
+
+    highp vec2 q = abs( pos ) - size + radii.x;
+    return min( max( q.x, q.y ), 0.0 ) + length( max( q, 0.0 ) ) - radii.x;
+}
+
+void main()
+{
+    highp float d = boxDistance( coord, extent, radius );
+    highp float aa = 0.5 * fwidth( d );
+
+    lowp float coverage = 1.0 - smoothstep( -aa, aa, d );
+
+    gl_FragColor = texture2D( source, texCoord ) * ( coverage * opacity );
+}
@@ -0,0 +1,16 @@
+uniform highp mat4 matrix;
+
+attribute highp vec4 in_vertex;
+attribute highp vec2 in_texCoord;
+attribute highp vec2 in_coord;
+
+varying highp vec2 texCoord;
+varying highp vec2 coord;
+
+void main()
+{
+    texCoord = in_texCoord;
+    coord = in_coord;
+
+    gl_Position = matrix * in_vertex;
+}
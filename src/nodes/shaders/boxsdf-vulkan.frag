@@ -0,0 +1,35 @@
+#version 440
+
+layout( location = 0 ) in vec2 coord;
+layout( location = 1 ) in vec3 extent;
+layout( location = 2 ) in vec4 radius;
+layout( location = 3 ) in vec4 fillColor;
+layout( location = 4 ) in vec4 borderColor;
+
+layout( location = 0 ) out vec4 fragColor;
+
+/*
+    coord: relative to the center of the box
+    extent: half of the size + border width
+    radius: bottomRight, topRight, bottomLeft, topLeft
+ */
+
+float boxDistance( in vec2 pos, in vec2 size, in vec4 radii )
+{
+    radii.xy = ( pos.x > 0.0 ) ? radii.xy : radii.zw;
+    radii.x = ( pos.y > 0.0 ) ? radii.x : radii.y;
+
+    vec2 q = abs( pos ) - size + radii.x;
+    return min( max( q.x, q.y ), 0.0 ) + length( max( q, 0.0 ) ) - radii.x;
+}
+
+void main()
+{
+    float d = boxDistance( coord, extent.xy, radius );
+    float aa = 0.5 * fwidth( d );
+
+    float outer = 1.0 - smoothstep( -aa, aa, d );
+    float inner = 1.0 - smoothstep( -aa, aa, d + extent.z );
+
+    fragColor = mix( borderColor, fillColor, inner ) * outer;
+}
@@ -0,0 +1,34 @@
+#version 440
+
+layout( location = 0 ) in vec4 in_vertex;
+layout( location = 1 ) in vec2 in_coord;
+layout( location = 2 ) in vec3 in_extent;
+layout( location = 3 ) in vec4 in_radius;
+layout( location = 4 ) in vec4 in_fillColor;
+layout( location = 5 ) in vec4 in_borderColor;
+
+layout( location = 0 ) out vec2 coord;
+layout( location = 1 ) out vec3 extent;
+layout( location = 2 ) out vec4 radius;
+layout( location = 3 ) out vec4 fillColor;
+layout( location = 4 ) out vec4 borderColor;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    float opacity;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    coord = in_coord;
+    extent = in_extent;
+    radius = in_radius;
+
+    fillColor = in_fillColor * ubuf.opacity;
+    borderColor = in_borderColor * ubuf.opacity;
+
+    gl_Position = ubuf.matrix * in_vertex;
+}
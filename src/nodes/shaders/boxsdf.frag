@@ -0,0 +1,29 @@
+#ifdef GL_ES
+#extension GL_OES_standard_derivatives : enable
+#endif
+
+varying highp vec2 coord;
+varying highp vec3 extent;
+varying highp vec4 radius;
+varying lowp vec4 fillColor;
+varying lowp vec4 borderColor;
+
+highp float boxDistance( in highp vec2 pos, in highp vec2 size, in highp vec4 radii )
+{
+    radii.xy = ( pos.x > 0.0 ) ? radii.xy : radii.zw;
+    radii.x = ( pos.y > 0.0 ) ? radii.x : radii.y;
+
+    highp vec2 q = abs( pos ) - size + radii.x;
+    return min( max( q.x, q.y ), 0.0 ) + length( max( q, 0.0 ) ) - radii.x;
+}
+
+void main()
+{
+    highp float d = boxDistance( coord, extent.xy, radius );
+    highp float aa = 0.5 * fwidth( d );
+
+    lowp float outer = 1.0 - smoothstep( -aa, aa, d );
+    lowp float inner = 1.0 - smoothstep( -aa, aa, d + extent.z );
+
+    gl_FragColor = mix( borderColor, fillColor, inner ) * outer;
+}
@@ -0,0 +1,27 @@
+uniform highp mat4 matrix;
+uniform lowp float opacity;
+
+attribute highp vec4 in_vertex;
+attribute highp vec2 in_coord;
+attribute highp vec3 in_extent;
+attribute highp vec4 in_radius;
+attribute lowp vec4 in_fillColor;
+attribute lowp vec4 in_borderColor;
+
+varying highp vec2 coord;
+varying highp vec3 extent;
+varying highp vec4 radius;
+varying lowp vec4 fillColor;
+varying lowp vec4 borderColor;
+
+void main()
+{
+    coord = in_coord;
+    extent = in_extent;
+    radius = in_radius;
+
+    fillColor = in_fillColor * opacity;
+    borderColor = in_borderColor * opacity;
+
+    gl_Position = matrix * in_vertex;
+}
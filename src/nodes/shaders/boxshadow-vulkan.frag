@@ -1,17 +1,11 @@
 #version 440
 
 layout( location = 0 ) in vec2 coord;
-layout( location = 0 ) out vec4 fragColor;
+layout( location = 1 ) in vec4 radius;
+layout( location = 2 ) in vec3 extent; // aspect, blurExtent
+layout( location = 3 ) in vec4 color;
 
-layout( std140, binding = 0 ) uniform buf
-{
-    mat4 matrix;
-    vec4 color;
-    vec4 radius;
-    vec2 aspect;
-    float blurExtent;
-    float opacity;
-} ubuf;
+layout( location = 0 ) out vec4 fragColor;
 
 float effectiveRadius( in vec4 radii, in vec2 point )
 {
@@ -25,24 +19,24 @@ void main()
 {
     vec4 col = vec4(0.0);
 
-    if ( ubuf.opacity > 0.0 )
+    if ( color.a > 0.0 )
     {
         const float minRadius = 0.05;
 
-        float e2 = 0.5 * ubuf.blurExtent;
-        float r = 2.0 * effectiveRadius( ubuf.radius, coord );
+        float e2 = 0.5 * extent.z;
+        float r = 2.0 * effectiveRadius( radius, coord );
 
         float f = minRadius / max( r, minRadius );
 
         r += e2 * f;
 
-        vec2 d = r + ubuf.blurExtent - ubuf.aspect * ( 1.0 - abs( 2.0 * coord ) );
+        vec2 d = r + extent.z - extent.xy * ( 1.0 - abs( 2.0 * coord ) );
         float l = min( max(d.x, d.y), 0.0) + length( max(d, 0.0) );
 
         float shadow = l - r;
 
         float v = smoothstep( -e2, e2, shadow );
-        col = mix( ubuf.color, vec4(0.0), v ) * ubuf.opacity;
+        col = mix( color, vec4(0.0), v );
     }
 
     fragColor = col; 
@@ -1,13 +1,23 @@
 uniform highp mat4 matrix;
-uniform lowp vec2 aspect;
+uniform lowp float opacity;
 
 attribute highp vec4 in_vertex;
 attribute mediump vec2 in_coord;
+attribute lowp vec4 in_radius;
+attribute lowp vec3 in_extent;
+attribute lowp vec4 in_color;
 
 varying mediump vec2 coord;
+varying lowp vec4 radius;
+varying lowp vec3 extent;
+varying lowp vec4 color;
 
 void main()
 {
     coord = in_coord;
+    radius = in_radius;
+    extent = in_extent;
+    color = in_color * opacity;
+
     gl_Position = matrix * in_vertex;
 }
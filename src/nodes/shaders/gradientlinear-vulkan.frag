@@ -8,13 +8,23 @@ layout( std140, binding = 0 ) uniform buf
     mat4 matrix;
     vec4 vector;
     float opacity;
+    vec4 ramp;
 } ubuf;
 
 layout( binding = 1 ) uniform sampler2D colorRamp;
 
 vec4 colorAt( float value )
 {
-    return texture( colorRamp, vec2( value, 0.0 ) );
+    // ramp: row, spread mode, offset, scale
+
+    if ( ubuf.ramp.y > 1.5 )
+        value = fract( value ); // repeat
+    else if ( ubuf.ramp.y > 0.5 )
+        value = 1.0 - abs( mod( value, 2.0 ) - 1.0 ); // reflect
+    else
+        value = clamp( value, 0.0, 1.0 ); // pad
+
+    return texture( colorRamp, vec2( ubuf.ramp.z + value * ubuf.ramp.w, ubuf.ramp.x ) );
 }
 
 void main()
@@ -9,6 +9,7 @@ layout( std140, binding = 0 ) uniform buf
     vec2 centerCoord;
     vec2 radius;
     float opacity;
+    vec4 ramp;
 } ubuf;
 
 out gl_PerVertex { vec4 gl_Position; };
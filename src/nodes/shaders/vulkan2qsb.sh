@@ -8,6 +8,12 @@ function qsbcompile {
 qsbcompile boxshadow-vulkan.vert
 qsbcompile boxshadow-vulkan.frag
 
+qsbcompile boxsdf-vulkan.vert
+qsbcompile boxsdf-vulkan.frag
+
+qsbcompile boxclip-vulkan.vert
+qsbcompile boxclip-vulkan.frag
+
 qsbcompile gradientconic-vulkan.vert
 qsbcompile gradientconic-vulkan.frag
 